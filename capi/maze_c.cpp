@@ -0,0 +1,144 @@
+/**
+ * @file maze_c.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 迷路ライブラリの C 言語インターフェース
+ * @date 2026.10.19
+ */
+#include "maze_c.h"
+
+#include "Maze.h"
+#include "StepMap.h"
+
+#include <new>     /*< for std::nothrow */
+#include <sstream> /*< for std::istringstream */
+
+using namespace MazeLib;
+
+/* ビット列の参照は，std::bitset がビットの順に詰められた整数の配列である
+ * ことを前提とする (libstdc++ と libc++ で成り立つ) */
+static_assert(sizeof(std::bitset<WallIndex::SIZE>) == WallIndex::SIZE / 8,
+              "unexpected std::bitset layout");
+/* C API は座標を int8_t，ステップを uint16_t として公開する */
+static_assert(!MAZE_LARGE, "maze_c supports MAZE_SIZE_CONFIG up to 32; "
+                           "build without the C API for larger mazes");
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "maze_c requires a little-endian target"
+#endif
+
+/* ハンドルの実体 */
+struct maze_maze {
+  Maze maze;
+};
+struct maze_step_map {
+  StepMap step_map;
+};
+
+static Positions to_positions(const maze_position_t *positions,
+                              const size_t count) {
+  Positions result;
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    result.push_back(Position(positions[i].x, positions[i].y));
+  return result;
+}
+
+uint32_t maze_abi_version(void) { return MAZE_C_ABI_VERSION; }
+int32_t maze_size(void) { return MAZE_SIZE; }
+int32_t maze_wall_count(void) { return WallIndex::SIZE; }
+
+maze_maze_t *maze_create(void) { return new (std::nothrow) maze_maze; }
+void maze_destroy(maze_maze_t *maze) { delete maze; }
+void maze_reset(maze_maze_t *maze) { maze->maze.reset(); }
+int32_t maze_parse(maze_maze_t *maze, const char *text) {
+  try {
+    std::istringstream iss(text);
+    return maze->maze.parse(iss);
+  } catch (...) {
+    return 0;
+  }
+}
+void maze_set_start(maze_maze_t *maze, const maze_position_t start) {
+  maze->maze.setStart(Position(start.x, start.y));
+}
+int32_t maze_set_goals(maze_maze_t *maze, const maze_position_t *goals,
+                       const size_t count) {
+  try {
+    maze->maze.setGoals(to_positions(goals, count));
+    return 1;
+  } catch (...) {
+    return 0;
+  }
+}
+int32_t maze_update_wall(maze_maze_t *maze, const int8_t x, const int8_t y,
+                         const int8_t d, const int32_t wall) {
+  try {
+    return maze->maze.updateWall(Position(x, y), Direction(d), wall != 0);
+  } catch (...) {
+    return 0;
+  }
+}
+int32_t maze_is_wall(const maze_maze_t *maze, const int8_t x, const int8_t y,
+                     const int8_t d) {
+  return maze->maze.isWall(Position(x, y), Direction(d));
+}
+int32_t maze_is_known(const maze_maze_t *maze, const int8_t x, const int8_t y,
+                      const int8_t d) {
+  return maze->maze.isKnown(Position(x, y), Direction(d));
+}
+const uint8_t *maze_wall_bits(const maze_maze_t *maze, size_t *nbytes) {
+  if (nbytes)
+    *nbytes = WallIndex::SIZE / 8;
+  return reinterpret_cast<const uint8_t *>(&maze->maze.getWallBits());
+}
+const uint8_t *maze_known_bits(const maze_maze_t *maze, size_t *nbytes) {
+  if (nbytes)
+    *nbytes = WallIndex::SIZE / 8;
+  return reinterpret_cast<const uint8_t *>(&maze->maze.getKnownBits());
+}
+
+maze_step_map_t *maze_step_map_create(void) {
+  return new (std::nothrow) maze_step_map;
+}
+void maze_step_map_destroy(maze_step_map_t *step_map) { delete step_map; }
+int32_t maze_step_map_update(maze_step_map_t *step_map,
+                             const maze_maze_t *maze,
+                             const maze_position_t *dest, const size_t count,
+                             const int32_t known_only, const int32_t simple) {
+  try {
+    step_map->step_map.update(maze->maze, to_positions(dest, count),
+                              known_only != 0, simple != 0);
+    return 1;
+  } catch (...) {
+    return 0;
+  }
+}
+int32_t maze_step_map_shortest(maze_step_map_t *step_map,
+                               const maze_maze_t *maze,
+                               const maze_position_t start,
+                               const maze_position_t *dest, const size_t count,
+                               const int32_t known_only, const int32_t simple,
+                               int8_t *dirs, const size_t capacity) {
+  try {
+    const auto shortest_dirs = step_map->step_map.calcShortestDirections(
+        maze->maze, Position(start.x, start.y), to_positions(dest, count),
+        known_only != 0, simple != 0);
+    if (shortest_dirs.empty())
+      return -1;
+    for (size_t i = 0; i < shortest_dirs.size() && i < capacity; ++i)
+      dirs[i] = shortest_dirs[i];
+    return shortest_dirs.size();
+  } catch (...) {
+    return -1;
+  }
+}
+uint16_t maze_step_map_get_step(const maze_step_map_t *step_map,
+                                const int8_t x, const int8_t y) {
+  return step_map->step_map.getStep(x, y);
+}
+const uint16_t *maze_step_map_array(const maze_step_map_t *step_map,
+                                    size_t *count) {
+  const auto &array = step_map->step_map.getMapArray();
+  if (count)
+    *count = array.size();
+  return array.data();
+}
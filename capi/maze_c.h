@@ -0,0 +1,166 @@
+/**
+ * @file maze_c.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 迷路ライブラリの C 言語インターフェース
+ * @date 2026.10.19
+ *
+ * Python (ctypes) や Rust (FFI) などから共有ライブラリ maze_c として使用する．
+ *
+ * - 迷路とステップマップは不透明なハンドルとして扱う
+ * - 整数の型はすべて固定幅であり，構造体は maze_position_t のみ
+ * - C++ の例外は関数の外に送出しない．失敗は戻り値で返す
+ * - ステップ配列と壁のビット列はコピーせずにポインタで参照できる．
+ *   ポインタはハンドルが破棄されるまで有効で，内容は更新に追従する
+ * - 互換性のない変更を行った場合は MAZE_C_ABI_VERSION を増やす
+ */
+#ifndef MAZE_C_H
+#define MAZE_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief ABI のバージョン */
+#define MAZE_C_ABI_VERSION 1
+
+/** @brief 公開する関数の属性 */
+#if defined(_WIN32)
+#define MAZE_C_API __declspec(dllexport)
+#else
+#define MAZE_C_API __attribute__((visibility("default")))
+#endif
+
+/** @brief 迷路のハンドル (MazeLib::Maze) */
+typedef struct maze_maze maze_maze_t;
+/** @brief ステップマップのハンドル (MazeLib::StepMap) */
+typedef struct maze_step_map maze_step_map_t;
+/** @brief 区画の位置 */
+typedef struct {
+  int8_t x; /**< @brief 区画座標の x 成分 */
+  int8_t y; /**< @brief 区画座標の y 成分 */
+} maze_position_t;
+
+/**
+ * @brief 共有ライブラリの ABI のバージョン．MAZE_C_ABI_VERSION と比較する
+ */
+MAZE_C_API uint32_t maze_abi_version(void);
+/**
+ * @brief コンパイル時に決めた迷路の一辺の区画数 (MAZE_SIZE)
+ */
+MAZE_C_API int32_t maze_size(void);
+
+/**
+ * @brief 迷路の生成．スタート区画は (0, 0)，ゴールはなし
+ * @return ハンドル．失敗した場合は NULL
+ */
+MAZE_C_API maze_maze_t *maze_create(void);
+/**
+ * @brief 迷路の破棄．NULL なら何もしない
+ */
+MAZE_C_API void maze_destroy(maze_maze_t *maze);
+/**
+ * @brief 迷路を初期化する．壁を削除し，スタート区画の壁を設定する
+ */
+MAZE_C_API void maze_reset(maze_maze_t *maze);
+/**
+ * @brief *.maze ファイル形式の文字列から迷路を読み込む
+ * @param text 終端文字のある文字列
+ * @return 1: 成功，0: 失敗
+ */
+MAZE_C_API int32_t maze_parse(maze_maze_t *maze, const char *text);
+/**
+ * @brief スタート区画の設定
+ */
+MAZE_C_API void maze_set_start(maze_maze_t *maze, maze_position_t start);
+/**
+ * @brief ゴール区画の集合の設定
+ * @return 1: 成功，0: 失敗
+ */
+MAZE_C_API int32_t maze_set_goals(maze_maze_t *maze,
+                                  const maze_position_t *goals, size_t count);
+/**
+ * @brief 既知の壁と照らし合わせながら壁を更新する (Maze::updateWall)
+ * @param d 方向．0: East, 2: North, 4: West, 6: South
+ * @param wall 0: 壁なし，それ以外: 壁あり
+ * @return 1: 正常に更新された，0: 既知の壁と不一致で未知壁に戻した
+ */
+MAZE_C_API int32_t maze_update_wall(maze_maze_t *maze, int8_t x, int8_t y,
+                                    int8_t d, int32_t wall);
+/**
+ * @brief 壁の有無．盤面外は壁ありとなる
+ */
+MAZE_C_API int32_t maze_is_wall(const maze_maze_t *maze, int8_t x, int8_t y,
+                                int8_t d);
+/**
+ * @brief 壁の既知未知．盤面外は既知となる
+ */
+MAZE_C_API int32_t maze_is_known(const maze_maze_t *maze, int8_t x, int8_t y,
+                                 int8_t d);
+/**
+ * @brief 壁と既知未知のビット列の参照
+ *
+ * ビット i (0 <= i < maze_wall_count()) は byte[i / 8] の (i % 8) ビット目．
+ * i は z * 4^MAZE_SIZE_BIT + y * 2^MAZE_SIZE_BIT + x (z は 0: 東壁, 1: 北壁)
+ * @param nbytes ビット列のバイト数の格納先．NULL でもよい
+ */
+MAZE_C_API const uint8_t *maze_wall_bits(const maze_maze_t *maze,
+                                         size_t *nbytes);
+MAZE_C_API const uint8_t *maze_known_bits(const maze_maze_t *maze,
+                                          size_t *nbytes);
+/**
+ * @brief ビット列の壁の数 (WallIndex::SIZE)
+ */
+MAZE_C_API int32_t maze_wall_count(void);
+
+/**
+ * @brief ステップマップの生成
+ * @return ハンドル．失敗した場合は NULL
+ */
+MAZE_C_API maze_step_map_t *maze_step_map_create(void);
+/**
+ * @brief ステップマップの破棄．NULL なら何もしない
+ */
+MAZE_C_API void maze_step_map_destroy(maze_step_map_t *step_map);
+/**
+ * @brief ステップマップの更新 (StepMap::update)
+ * @param dest 目的地区画の配列
+ * @param known_only 0 以外: 未知壁は通過不可能
+ * @param simple 0 以外: 隣接区画のコストをすべて1にする
+ * @return 1: 成功，0: 失敗
+ */
+MAZE_C_API int32_t maze_step_map_update(maze_step_map_t *step_map,
+                                        const maze_maze_t *maze,
+                                        const maze_position_t *dest,
+                                        size_t count, int32_t known_only,
+                                        int32_t simple);
+/**
+ * @brief 最短経路の導出 (StepMap::calcShortestDirections)
+ * @param dirs 方向列の格納先．capacity 個まで格納する
+ * @return 経路の長さ．capacity を超える場合も全長を返す．経路がない場合は -1
+ */
+MAZE_C_API int32_t maze_step_map_shortest(
+    maze_step_map_t *step_map, const maze_maze_t *maze, maze_position_t start,
+    const maze_position_t *dest, size_t count, int32_t known_only,
+    int32_t simple, int8_t *dirs, size_t capacity);
+/**
+ * @brief ステップの取得．盤面外なら UINT16_MAX
+ */
+MAZE_C_API uint16_t maze_step_map_get_step(const maze_step_map_t *step_map,
+                                           int8_t x, int8_t y);
+/**
+ * @brief ステップ配列の参照 (StepMap::getMapArray)
+ *
+ * 区画 (x, y) のステップは steps[x * 2^MAZE_SIZE_BIT + y]．
+ * @param count 配列の要素数の格納先．NULL でもよい
+ */
+MAZE_C_API const uint16_t *
+maze_step_map_array(const maze_step_map_t *step_map, size_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MAZE_C_H */
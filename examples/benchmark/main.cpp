@@ -0,0 +1,82 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief ステップマップの更新の実装ごとの処理時間の比較
+ * @date 2026.10.19
+ */
+
+/*
+ * 迷路ライブラリのインクルード
+ */
+#include "MazeGenerator.h"
+#include "StepMap.h"
+
+/*
+ * 標準ライブラリのインクルード
+ */
+#include <algorithm> //< for std::min
+#include <chrono>    //< for std::chrono
+#include <cstdio>    //< for std::printf
+
+/**
+ * @brief 名前空間の展開
+ */
+using namespace MazeLib;
+
+/**
+ * @brief 更新の処理時間を計測する関数
+ * @return 1回あたりの処理時間 [us] (繰り返しの最小値)
+ */
+double Measure(const Maze &maze, const bool known_only, const bool simple,
+               const StepMap::Backend backend) {
+  StepMap step_map;
+  const int n = 200;
+  double best = 1e9;
+  for (int r = 0; r < 5; ++r) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+      step_map.update(maze, maze.getGoals(), known_only, simple, backend);
+    const auto t1 = std::chrono::steady_clock::now();
+    best = std::min(
+        best, std::chrono::duration<double, std::micro>(t1 - t0).count() / n);
+  }
+  return best;
+}
+
+/**
+ * @brief main 関数
+ */
+int main(void) {
+  const char *style_names[] = {"Perfect", "Braided", "Straight", "Diagonal"};
+  const bool simple = false;
+  std::printf("%-9s %4s %6s %11s %11s %7s\n", "style", "seed", "known",
+              "Queue [us]", "Sweep [us]", "winner");
+  int wins[2] = {};
+  for (int style = 0; style < 4; ++style)
+    for (int seed = 0; seed < 3; ++seed)
+      for (const int known_percent : {0, 50, 100}) {
+        /* 迷路を生成し，壁を一部だけ既知にする */
+        MazeGenerator generator(seed);
+        MazeGenerator::Config config;
+        config.style = MazeGenerator::Style(style);
+        Maze maze_target, maze;
+        generator.generate(maze_target, config);
+        maze.setGoals(maze_target.getGoals());
+        for (coord_t x = 0; x < MAZE_SIZE; ++x)
+          for (coord_t y = 0; y < MAZE_SIZE; ++y)
+            for (const auto d : {Direction::East, Direction::North})
+              if (int(generator.random(100)) < known_percent)
+                maze.updateWall(Position(x, y), d,
+                                maze_target.isWall(x, y, d));
+        /* 未知壁を壁なしとした場合の更新の処理時間 */
+        const double t_queue = Measure(maze, false, simple, StepMap::Queue);
+        const double t_sweep = Measure(maze, false, simple, StepMap::Sweep);
+        const bool sweep_wins = t_sweep < t_queue;
+        ++wins[sweep_wins];
+        std::printf("%-9s %4d %5d%% %11.2f %11.2f %7s\n", style_names[style],
+                    seed, known_percent, t_queue, t_sweep,
+                    sweep_wins ? "Sweep" : "Queue");
+      }
+  std::printf("Queue wins: %d, Sweep wins: %d\n", wins[0], wins[1]);
+  return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 複数のエージェントによる協調探索のシミュレーション
+ * @date 2026.10.19
+ */
+
+/*
+ * 迷路ライブラリのインクルード
+ */
+#include "MazeGenerator.h"
+#include "MultiAgentPlanner.h"
+
+/*
+ * 標準ライブラリのインクルード
+ */
+#include <cstdio> //< for std::printf
+
+/**
+ * @brief 名前空間の展開
+ */
+using namespace MazeLib;
+
+/**
+ * @brief シミュレーション上のエージェント
+ */
+struct Agent {
+  Pose pose;     /**< @brief 現在の位置姿勢 */
+  Maze observed; /**< @brief 自身が観測した壁 */
+  int busy = 0;  /**< @brief 移動したステップ数 */
+};
+
+/**
+ * @brief 協調探索のシミュレーション
+ *
+ * 1区画の移動を1ステップとし，全エージェントが同時に1区画ずつ移動する．
+ * 各ステップで，各エージェントは現在区画の前・左・右の壁を観測し，
+ * 共有の迷路に統合してから目的区画の割り当てを受ける．
+ * エージェント同士の衝突は考慮しない．
+ * @param maze_target 正解の迷路
+ * @param agent_count エージェントの数
+ * @param full true: 全区画を探索，false: 最短経路が確定するまで探索
+ * @param utilization 各エージェントの稼働率 (移動したステップの割合)
+ * @return 探索の完了までのステップ数．失敗なら -1
+ */
+int Simulate(const Maze &maze_target, const int agent_count, const bool full,
+             std::vector<double> &utilization) {
+  Maze maze(maze_target.getGoals());
+  MultiAgentPlanner planner(maze, agent_count);
+  std::vector<Agent> agents(agent_count);
+  for (auto &agent : agents)
+    agent.pose = Pose(maze.getStart(), Direction::North);
+  const int step_max = 100 * MAZE_SIZE * MAZE_SIZE;
+  int step = 0;
+  for (; step < step_max; ++step) {
+    /* 壁を確認．ここでは maze_target を参照しているが，実際には壁を見る */
+    Positions positions;
+    for (auto &agent : agents) {
+      for (const auto rd :
+           {Direction::Front, Direction::Left, Direction::Right}) {
+        const auto d = agent.pose.d + rd;
+        agent.observed.updateWall(agent.pose.p, d,
+                                  maze_target.isWall(agent.pose.p, d), false);
+      }
+      planner.merge(agent.observed);
+      positions.push_back(agent.pose.p);
+    }
+    /* 目的区画の割り当て．割り当てがなければ探索終了 */
+    if (!planner.assign(positions, true, full))
+      break;
+    /* 経路の最初の1区画を進む */
+    for (int a = 0; a < agent_count; ++a) {
+      const auto &dirs = planner.getAssignments()[a].dirs;
+      if (dirs.empty())
+        continue;
+      agents[a].pose = agents[a].pose.next(dirs.front());
+      ++agents[a].busy;
+    }
+  }
+  if (step == step_max)
+    return -1;
+  utilization.clear();
+  for (const auto &agent : agents)
+    utilization.push_back(step ? double(agent.busy) / step : 0);
+  /* 既知壁のみの最短経路が存在すること */
+  StepMap step_map;
+  if (step_map
+          .calcShortestDirections(maze, maze.getStart(), maze.getGoals(), true,
+                                  false)
+          .empty())
+    return -1;
+  return step;
+}
+
+/**
+ * @brief エージェントの数ごとに，複数の迷路の平均の探索時間を表示する関数
+ * @return 0: 成功，-1: 失敗
+ */
+int Run(const int agent_count_max, const int seed_count, const bool full) {
+  std::printf("%6s %8s %8s  %s\n", "agents", "steps", "speedup",
+              "utilization of each agent");
+  double steps_single = 0;
+  for (int agent_count = 1; agent_count <= agent_count_max; ++agent_count) {
+    /* 複数の迷路の平均 */
+    double steps = 0;
+    std::vector<double> utilization_sum(agent_count);
+    for (int seed = 0; seed < seed_count; ++seed) {
+      Maze maze_target;
+      MazeGenerator(seed).generate(maze_target);
+      std::vector<double> utilization;
+      const int result = Simulate(maze_target, agent_count, full, utilization);
+      if (result < 0) {
+        std::printf("failed to explore the maze of seed %d\n", seed);
+        return -1;
+      }
+      steps += double(result) / seed_count;
+      for (int a = 0; a < agent_count; ++a)
+        utilization_sum[a] += utilization[a] / seed_count;
+    }
+    if (agent_count == 1)
+      steps_single = steps;
+    std::printf("%6d %8.1f %7.2fx ", agent_count, steps, steps_single / steps);
+    for (const auto u : utilization_sum)
+      std::printf(" %5.1f%%", 100 * u);
+    std::printf("\n");
+  }
+  return 0;
+}
+
+/**
+ * @brief main 関数
+ */
+int main(void) {
+  const int agent_count_max = 4;
+  const int seed_count = 8;
+  for (const bool full : {false, true}) {
+    std::printf("%s\n", full ? "[Exploring all cells]"
+                             : "[Exploring until the shortest path is found]");
+    if (Run(agent_count_max, seed_count, full))
+      return -1;
+  }
+  return 0;
+}
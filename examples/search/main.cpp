@@ -8,7 +8,10 @@
 /*
  * 迷路ライブラリのインクルード
  */
+#include "LiveView.h"
 #include "Maze.h"
+#include "SearchAlgorithm.h"
+#include "SpeculativePlanner.h"
 #include "StepMap.h"
 
 /*
@@ -48,6 +51,9 @@ void MoveRobot(const Direction relative_dir) {
 int SearchRun(Maze &maze, const Maze &maze_target) {
   /* 探索テスト */
   StepMap step_map; //< 経路導出に使用するステップマップ
+  SearchAlgorithm search_algorithm(maze); //< 探索目的地の選定に使用
+  SpeculativePlanner planner; //< 移動中に次の区画の壁の組合せごとに先行導出
+  LiveView live_view; //< 差分のみを描画するアニメーション表示
   /* 現在方向は，現在区画に向かう方向を表す．
    * 現在区画から出る方向ではないことに注意する．
    * +---+---+---+ 例
@@ -61,6 +67,8 @@ int SearchRun(Maze &maze, const Maze &maze_target) {
   Position current_pos = Position(0, 0);    //< 現在の区画位置
   Direction current_dir = Direction::North; //< 現在向いている方向
   /* 1. ゴールへ向かう探索走行 */
+  planner.prepare(maze, {current_pos, current_dir}, maze.getGoals(), false,
+                  true);
   while (1) {
     /* 壁を確認．ここでは maze_target を参照しているが，実際には壁を見る */
     const bool wall_front =
@@ -69,6 +77,9 @@ int SearchRun(Maze &maze, const Maze &maze_target) {
         maze_target.isWall(current_pos, current_dir + Direction::Left);
     const bool wall_right =
         maze_target.isWall(current_pos, current_dir + Direction::Right);
+    /* 移動中に先行導出しておいた，観測結果に対応する移動方向を引く */
+    const auto next = planner.lookup(wall_front, wall_left, wall_right);
+    step_map = planner.getStepMap(); //< 表示用に複製
     /* 迷路の壁を更新 */
     maze.updateWall(current_pos, current_dir + Direction::Front, wall_front);
     maze.updateWall(current_pos, current_dir + Direction::Left, wall_left);
@@ -77,19 +88,21 @@ int SearchRun(Maze &maze, const Maze &maze_target) {
     const auto &goals = maze.getGoals();
     if (std::find(goals.cbegin(), goals.cend(), current_pos) != goals.cend())
       break;
-    /* 現在地からゴールへの移動経路を，未知壁はないものとして導出 */
-    const auto move_dirs = step_map.calcShortestDirections(
-        maze, current_pos, maze.getGoals(), false, true);
+    /* 既知区間を進む．既知区間がなければ候補の先頭の方向へ1区画進む */
+    auto move_dirs = next.known;
+    if (move_dirs.empty() && !next.candidates.empty())
+      move_dirs.push_back(next.candidates[0]);
     /* エラー処理 */
     if (move_dirs.empty()) {
       loge << "Failed to Find a path to goal!" << std::endl;
       return -1;
     }
-    /* 未知壁のある区画に当たるまで進む */
+    /* 次に壁を確認する区画に向かいながら，その区画の経路を先行導出 */
+    auto next_pose = Pose(current_pos, current_dir);
+    for (const auto next_dir : move_dirs)
+      next_pose = next_pose.next(next_dir);
+    planner.prepare(maze, next_pose, maze.getGoals(), false, true);
     for (const auto next_dir : move_dirs) {
-      /* 未知壁があったら終了 */
-      if (maze.unknownCount(current_pos))
-        break;
       /* ロボットを動かす */
       const auto relative_dir = Direction(next_dir - current_dir);
       MoveRobot(relative_dir);
@@ -97,8 +110,8 @@ int SearchRun(Maze &maze, const Maze &maze_target) {
       current_pos = current_pos.next(next_dir);
       current_dir = next_dir;
       /* アニメーション表示 */
-      step_map.print(maze, current_pos, current_dir);
-      std::cout << "Searching for goal" << std::endl;
+      live_view.draw(maze, step_map, current_pos, current_dir,
+                     "Searching for goal");
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
   }
@@ -115,16 +128,12 @@ int SearchRun(Maze &maze, const Maze &maze_target) {
     maze.updateWall(current_pos, current_dir + Direction::Front, wall_front);
     maze.updateWall(current_pos, current_dir + Direction::Left, wall_left);
     maze.updateWall(current_pos, current_dir + Direction::Right, wall_right);
-    /* 最短経路上の未知区画を洗い出し */
-    const auto shortest_dirs = step_map.calcShortestDirections(
-        maze, maze.getStart(), maze.getGoals(), false, false);
-    Positions shortest_candidates;
-    auto pos = maze.getStart();
-    for (const auto next_dir : shortest_dirs) {
-      pos = pos.next(next_dir);
-      if (maze.unknownCount(pos))
-        shortest_candidates.push_back(pos);
-    }
+    /* 既知壁のみの最短経路がこれ以上短くならなければ次へ */
+    if (search_algorithm.isShortestDetermined(0, false))
+      break;
+    /* 最短経路のコストを変え得る未知壁に隣接する区画を洗い出し */
+    const auto shortest_candidates =
+        search_algorithm.findShortestCandidates(false);
     /* 最短経路上に未知区画がなければ次へ */
     if (shortest_candidates.empty())
       break;
@@ -148,38 +157,63 @@ int SearchRun(Maze &maze, const Maze &maze_target) {
       current_pos = current_pos.next(next_dir);
       current_dir = next_dir;
       /* アニメーション表示 */
-      step_map.print(maze, current_pos, current_dir);
-      std::cout << "Finding shortest path" << std::endl;
+      live_view.draw(maze, step_map, current_pos, current_dir,
+                     "Finding shortest path");
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
   }
   /* 3. スタート区画へ戻る走行 */
+  /* 既知壁のみの最短経路の 1.2 倍の時間までは，未知壁を観測できる経路を選ぶ */
+  step_map.calcShortestDirections(maze, current_pos, {maze.getStart()}, true,
+                                  false);
+  const auto return_budget = step_map.getStep(current_pos) / 5 * 6;
+  Directions return_dirs; //< 帰還の走行で移動した方向列
   while (1) {
+    /* 壁を確認．ここでは maze_target を参照しているが，実際には壁を見る */
+    const bool wall_front =
+        maze_target.isWall(current_pos, current_dir + Direction::Front);
+    const bool wall_left =
+        maze_target.isWall(current_pos, current_dir + Direction::Left);
+    const bool wall_right =
+        maze_target.isWall(current_pos, current_dir + Direction::Right);
+    /* 迷路の壁を更新 */
+    maze.updateWall(current_pos, current_dir + Direction::Front, wall_front);
+    maze.updateWall(current_pos, current_dir + Direction::Left, wall_left);
+    maze.updateWall(current_pos, current_dir + Direction::Right, wall_right);
     /* 現在地のスタート区画判定 */
     if (current_pos == maze.getStart())
       break;
-    /* 現在地からスタートへの最短経路を既知壁のみの経路で導出 */
-    const auto move_dirs = step_map.calcShortestDirections(
-        maze, current_pos, {maze.getStart()}, true, true);
+    /* 残りの時間の余裕の範囲で，スタートへの経路を導出 */
+    const auto spent = step_map.calcRouteCost(return_dirs, false);
+    const auto move_dirs = search_algorithm.calcReturnDirections(
+        current_pos, return_budget > spent ? return_budget - spent : 0, 8,
+        false);
     /* エラー処理 */
     if (move_dirs.empty()) {
       loge << "Failed to Find a path to goal!" << std::endl;
       return -1;
     }
-    /* 経路上を進む */
+    /* 未知壁のある区画に当たるまで進む */
     for (const auto next_dir : move_dirs) {
+      /* 未知壁があったら終了 */
+      if (maze.unknownCount(current_pos))
+        break;
       /* ロボットを動かす */
       const auto relative_dir = Direction(next_dir - current_dir);
       MoveRobot(relative_dir);
       /* 現在地を進める */
       current_pos = current_pos.next(next_dir);
       current_dir = next_dir;
+      return_dirs.push_back(next_dir);
       /* アニメーション表示 */
-      step_map.print(maze, current_pos, current_dir);
-      std::cout << "Going back to start" << std::endl;
+      live_view.draw(maze, step_map, current_pos, current_dir,
+                     "Going back to start");
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
   }
+  /* 最後のフレームはフレームレートによらず描画 */
+  live_view.draw(maze, step_map, current_pos, current_dir, "Arrived at start",
+                 std::cout, true);
   /* 正常終了 */
   return 0;
 }
@@ -190,6 +224,7 @@ int SearchRun(Maze &maze, const Maze &maze_target) {
 int ShortestRun(const Maze &maze) {
   /* スタートからゴールまでの最短経路導出 */
   StepMap step_map;
+  LiveView live_view;
   const auto shortest_dirs = step_map.calcShortestDirections(
       maze, maze.getStart(), maze.getGoals(), true, false);
   if (shortest_dirs.empty()) {
@@ -207,10 +242,13 @@ int ShortestRun(const Maze &maze) {
     current_pos = current_pos.next(next_dir);
     current_dir = next_dir;
     /* アニメーション表示 */
-    step_map.print(maze, current_pos, current_dir);
-    std::cout << "Shortest Run" << std::endl;
+    live_view.draw(maze, step_map, current_pos, current_dir,
+                   "Shortest Run");
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
+  /* 最後のフレームはフレームレートによらず描画 */
+  live_view.draw(maze, step_map, current_pos, current_dir, "Shortest Run",
+                 std::cout, true);
   /* 最短経路の表示 */
   maze.print(shortest_dirs);
   /* 終了 */
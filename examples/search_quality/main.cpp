@@ -0,0 +1,292 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 探索の方針ごとのロボットの走行コストの比較
+ * @date 2026.10.19
+ *
+ * 使い方: example_search_quality [-b baseline.csv] [-u] [maze files or dirs]
+ * - 各迷路について，探索の方針ごとにスタートからゴールまでの探索，
+ *   最短経路を確定する探索，スタートへの帰還までを並列にシミュレーションする
+ * - 走行した区画数，ターン数，推定走行時間を表示する
+ * - -b で与えたベースラインとの差分を表示する．-u でベースラインを更新する
+ * - 迷路を与えない場合は ../mazedata/data を読み，なければ生成した迷路を使う
+ */
+
+/*
+ * 迷路ライブラリのインクルード
+ */
+#include "MazeGenerator.h"
+#include "SearchAlgorithm.h"
+#include "StepMap.h"
+
+/*
+ * 標準ライブラリのインクルード
+ */
+#include <algorithm> //< for std::find
+#include <cstdio>    //< for std::printf
+#include <cstring>   //< for std::strcmp
+#include <dirent.h>  //< for opendir
+#include <future>    //< for std::async
+#include <map>       //< for std::map
+#include <sstream>   //< for std::istringstream
+
+/**
+ * @brief 名前空間の展開
+ */
+using namespace MazeLib;
+
+/**
+ * @brief 比較する探索の方針
+ */
+static const std::vector<std::pair<StepMap::CandidateOrder, std::string>>
+    strategies = {
+        {StepMap::StraightFirst, "straight"},
+        {StepMap::UnknownFirst, "unknown"},
+        {StepMap::CostOnly, "cost"},
+};
+
+/**
+ * @brief 探索走行1回の走行コスト
+ */
+struct Result {
+  int cells = 0;      /**< @brief 走行した区画数 */
+  int turns = 0;      /**< @brief ターン数 (180度ターンを含む) */
+  double seconds = 0; /**< @brief 推定走行時間 [s] */
+};
+
+/**
+ * @brief 探索走行のシミュレーション
+ *
+ * examples/search と同じ3段階の探索を行う．ただし方針を同じ条件で比べる
+ * ため，スタートへの帰還は既知壁のみの最短経路とする．
+ * 未知壁のある区画では，方針に従った候補の先頭の方向に1区画進む．
+ * @return 走行コスト．失敗なら区画数が負
+ */
+Result Search(const Maze &maze_target, const StepMap::CandidateOrder order) {
+  Maze maze(maze_target.getGoals(), maze_target.getStart());
+  SearchAlgorithm search_algorithm(maze);
+  StepMap step_map;
+  Pose pose(maze.getStart(), Direction::North);
+  Directions trace;
+  const int step_max = 16 * MAZE_SIZE * MAZE_SIZE;
+  /* 目的地へ向かって，未知壁のある区画では1区画ずつ進む */
+  const auto go = [&](const Positions &dest) {
+    /* 壁を確認．ここでは maze_target を参照しているが，実際には壁を見る */
+    for (const auto rd : {Direction::Front, Direction::Left, Direction::Right})
+      maze.updateWall(pose.p, pose.d + rd,
+                      maze_target.isWall(pose.p, pose.d + rd));
+    step_map.update(maze, dest, false, true);
+    Directions known_dirs, candidates;
+    step_map.calcNextDirections(maze, pose, known_dirs, candidates, order);
+    if (known_dirs.empty() && !candidates.empty())
+      known_dirs.push_back(candidates.front());
+    for (const auto d : known_dirs)
+      trace.push_back(d), pose = pose.next(d);
+    return !known_dirs.empty();
+  };
+  /* 1. ゴールへ向かう探索走行 */
+  const auto &goals = maze.getGoals();
+  while (std::find(goals.cbegin(), goals.cend(), pose.p) == goals.cend())
+    if (int(trace.size()) > step_max || !go(goals))
+      return Result{-1};
+  /* 2. 最短経路上の未知区画をつぶす探索走行 */
+  while (!search_algorithm.isShortestDetermined(0, false)) {
+    const auto candidates = search_algorithm.findShortestCandidates(false);
+    if (candidates.empty())
+      break;
+    if (int(trace.size()) > step_max || !go(candidates))
+      return Result{-1};
+  }
+  /* 3. スタート区画へ戻る走行 */
+  for (const auto d : step_map.calcShortestDirections(
+           maze, pose.p, {maze.getStart()}, true, false))
+    trace.push_back(d), pose = pose.next(d);
+  if (pose.p != maze.getStart())
+    return Result{-1};
+  /* 走行コストの集計 */
+  Result result;
+  result.cells = trace.size();
+  for (size_t i = 1; i < trace.size(); ++i)
+    result.turns += trace[i] != trace[i - 1];
+  result.seconds =
+      step_map.calcRouteCost(trace, false) * CostModel().scaling / 1000.0;
+  return result;
+}
+
+/**
+ * @brief 迷路ファイルの1辺の区画数を，1行目の長さから求める関数
+ */
+int GetMazeSize(const std::string &file_path) {
+  std::ifstream ifs(file_path);
+  std::string line;
+  while (std::getline(ifs, line))
+    if (!line.empty())
+      return (line.size() - 1) / 4;
+  return 0;
+}
+
+/**
+ * @brief 迷路ファイルまたはそれを含むディレクトリから迷路を読み込む関数
+ * @details MAZE_SIZE より大きい迷路は読み飛ばす
+ */
+void LoadMazes(const std::string &path,
+               std::vector<std::pair<std::string, Maze>> &mazes) {
+  std::vector<std::string> files;
+  if (DIR *dir = opendir(path.c_str())) {
+    while (const auto *entry = readdir(dir)) {
+      const std::string name = entry->d_name;
+      if (name.size() > 5 && name.substr(name.size() - 5) == ".maze")
+        files.push_back(path + "/" + name);
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+  } else {
+    files.push_back(path);
+  }
+  for (const auto &file : files) {
+    const auto size = GetMazeSize(file);
+    if (size < 1 || size > MAZE_SIZE)
+      continue;
+    Maze maze;
+    if (maze.parse(file))
+      mazes.push_back({file.substr(file.find_last_of('/') + 1), maze});
+  }
+}
+
+/**
+ * @brief ベースラインの読み込み．キーは "迷路名,方針名"
+ */
+std::map<std::string, Result> LoadBaseline(const std::string &file_path) {
+  std::map<std::string, Result> baseline;
+  std::ifstream ifs(file_path);
+  std::string line;
+  std::getline(ifs, line); //< skip the header
+  while (std::getline(ifs, line)) {
+    std::istringstream iss(line);
+    std::string maze, strategy, cells, turns, seconds;
+    std::getline(iss, maze, ','), std::getline(iss, strategy, ',');
+    std::getline(iss, cells, ','), std::getline(iss, turns, ',');
+    std::getline(iss, seconds, ',');
+    if (seconds.empty())
+      continue;
+    baseline[maze + "," + strategy] =
+        Result{std::stoi(cells), std::stoi(turns), std::stod(seconds)};
+  }
+  return baseline;
+}
+
+/**
+ * @brief main 関数
+ */
+int main(int argc, char *argv[]) {
+  /* 引数の解析 */
+  std::string baseline_path;
+  bool update_baseline = false;
+  std::vector<std::string> maze_paths;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "-u"))
+      update_baseline = true;
+    else if (!std::strcmp(argv[i], "-b") && i + 1 < argc)
+      baseline_path = argv[++i];
+    else
+      maze_paths.push_back(argv[i]);
+  }
+  if (maze_paths.empty())
+    maze_paths.push_back("../mazedata/data");
+  std::vector<std::pair<std::string, Maze>> mazes;
+  for (const auto &path : maze_paths)
+    LoadMazes(path, mazes);
+  if (mazes.empty()) {
+    /* 迷路データがなければ生成した迷路を使う */
+    const char *style_names[] = {"perfect", "braided", "straight", "diagonal"};
+    for (int style = 0; style < 4; ++style)
+      for (int seed = 0; seed < 8; ++seed) {
+        MazeGenerator::Config config;
+        config.style = MazeGenerator::Style(style);
+        Maze maze;
+        MazeGenerator(seed).generate(maze, config);
+        mazes.push_back({std::string("generated-") + style_names[style] + "-" +
+                             std::to_string(seed),
+                         maze});
+      }
+  }
+  /* 迷路と方針の組ごとに並列にシミュレーション */
+  std::vector<std::vector<std::future<Result>>> futures(mazes.size());
+  for (size_t m = 0; m < mazes.size(); ++m)
+    for (const auto &strategy : strategies)
+      futures[m].push_back(std::async(std::launch::async, Search,
+                                      std::cref(mazes[m].second),
+                                      strategy.first));
+  /* 結果の表示とベースラインとの比較 */
+  const auto baseline = LoadBaseline(baseline_path);
+  std::vector<Result> totals(strategies.size());
+  std::vector<int> wins(strategies.size()), losses(strategies.size());
+  std::ostringstream csv;
+  csv << "maze,strategy,cells,turns,seconds" << std::endl;
+  int failures = 0, regressions = 0;
+  std::printf("%-28s", "maze");
+  for (const auto &strategy : strategies)
+    std::printf(" %22s", (strategy.second + " cells/turns/s").c_str());
+  std::printf("\n");
+  for (size_t m = 0; m < mazes.size(); ++m) {
+    std::printf("%-28s", mazes[m].first.c_str());
+    std::vector<Result> results;
+    for (size_t s = 0; s < strategies.size(); ++s) {
+      const auto r = futures[m][s].get();
+      results.push_back(r);
+      if (r.cells < 0) {
+        std::printf(" %22s", "failed");
+        ++failures;
+        continue;
+      }
+      totals[s].cells += r.cells, totals[s].turns += r.turns;
+      totals[s].seconds += r.seconds;
+      /* ベースラインとの差分 */
+      const auto key = mazes[m].first + "," + strategies[s].second;
+      const auto it = baseline.find(key);
+      const double diff =
+          it == baseline.end() ? 0 : r.seconds - it->second.seconds;
+      regressions += diff > 1e-6;
+      const char *mark = diff > 1e-6 ? " +" : diff < -1e-6 ? " -" : "  ";
+      char cell[32];
+      std::snprintf(cell, sizeof(cell), "%d/%d/%.2f%s", r.cells, r.turns,
+                    r.seconds, mark);
+      std::printf(" %22s", cell);
+      csv << key << "," << r.cells << "," << r.turns << "," << r.seconds
+          << std::endl;
+    }
+    std::printf("\n");
+    /* 既定の方針 (先頭) との1対1の比較 */
+    for (size_t s = 1; s < results.size(); ++s) {
+      if (results[0].cells < 0 || results[s].cells < 0)
+        continue;
+      wins[s] += results[s].seconds < results[0].seconds - 1e-6;
+      losses[s] += results[s].seconds > results[0].seconds + 1e-6;
+    }
+  }
+  /* 集計 */
+  std::printf("%-28s", "total");
+  for (const auto &t : totals) {
+    char cell[32];
+    std::snprintf(cell, sizeof(cell), "%d/%d/%.1f  ", t.cells, t.turns,
+                  t.seconds);
+    std::printf(" %22s", cell);
+  }
+  std::printf("\n%-28s", ("win/lose vs " + strategies[0].second).c_str());
+  for (size_t s = 0; s < strategies.size(); ++s) {
+    char cell[32];
+    std::snprintf(cell, sizeof(cell), "%d/%d  ", wins[s], losses[s]);
+    std::printf(" %22s", s ? cell : "-  ");
+  }
+  std::printf("\n");
+  if (!baseline_path.empty() && !baseline.empty())
+    std::printf("%d regressions against %s (+: slower, -: faster)\n",
+                regressions, baseline_path.c_str());
+  /* ベースラインの更新 */
+  if (update_baseline && !baseline_path.empty()) {
+    std::ofstream ofs(baseline_path);
+    ofs << csv.str();
+    std::printf("updated %s\n", baseline_path.c_str());
+  }
+  return failures ? -1 : 0;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief ステップマップの更新と経路の導出の最悪実行時間の探索
+ * @date 2026.10.19
+ *
+ * 使い方: example_wcet [-n iterations] [maze files or dirs]
+ * - 迷路データと生成した迷路について，既知壁のみかどうかと台形加速の
+ *   有無の組ごとに，StepMap::update() と getStepDownDirections() の
+ *   処理時間，区画の展開数，更新予約のキューの最大長を求める
+ * - 展開数が最大の迷路から壁を1枚ずつ反転させる山登りを -n 回行い，
+ *   展開数がさらに大きくなる迷路を探す
+ * - 各最大値とその入力を表示する．キューの最大長が StepQueue::CAPACITY
+ *   を超えたら異常終了する
+ * - 迷路を与えない場合は ../mazedata/data を読む
+ */
+
+/*
+ * 迷路ライブラリのインクルード
+ */
+#include "MazeGenerator.h"
+#include "StepMapAnytime.h"
+
+/*
+ * 標準ライブラリのインクルード
+ */
+#include <algorithm> //< for std::max
+#include <chrono>    //< for std::chrono
+#include <cstdio>    //< for std::printf
+#include <cstring>   //< for std::strcmp
+#include <dirent.h>  //< for opendir
+#include <random>    //< for std::mt19937
+
+/**
+ * @brief 名前空間の展開
+ */
+using namespace MazeLib;
+
+/**
+ * @brief 1つの入力に対する計算量
+ */
+struct Work {
+  int expansions = 0;      /**< @brief 展開した区画の数 */
+  int queue_peak = 0;      /**< @brief 更新予約のキューの最大長 */
+  double update_us = 0;    /**< @brief StepMap::update() の処理時間 */
+  double step_down_us = 0; /**< @brief getStepDownDirections() の処理時間 */
+};
+
+/**
+ * @brief 展開数とキューの最大長を数える関数
+ * @details StepMapAnytime を1区画ずつ進め，処理時間によらず決定的に数える
+ */
+Work Count(const Maze &maze, const bool known_only, const bool simple) {
+  Work work;
+  StepMapAnytime anytime;
+  anytime.start(maze.getGoals(), known_only, simple);
+  work.queue_peak = anytime.getQueueSize();
+  while (!anytime.resume(maze, 1))
+    work.queue_peak = std::max(work.queue_peak, anytime.getQueueSize());
+  work.expansions = anytime.getExpansionCount();
+  return work;
+}
+
+/**
+ * @brief 処理時間を計測する関数
+ * @return 1回の処理時間 [us] (割り込みの影響を除くため繰り返しの最小値)
+ */
+template <typename F> double Measure(const F &f) {
+  double best = 1e9;
+  for (int r = 0; r < 20; ++r) {
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    const auto t1 = std::chrono::steady_clock::now();
+    best = std::min(best,
+                    std::chrono::duration<double, std::micro>(t1 - t0).count());
+  }
+  return best;
+}
+
+/**
+ * @brief 展開数，キューの最大長，処理時間を求める関数
+ */
+Work Evaluate(const Maze &maze, const bool known_only, const bool simple) {
+  auto work = Count(maze, known_only, simple);
+  StepMap step_map;
+  work.update_us = Measure(
+      [&] { step_map.update(maze, maze.getGoals(), known_only, simple); });
+  Pose end;
+  work.step_down_us = Measure([&] {
+    step_map.getStepDownDirections(maze, {maze.getStart(), Direction::Max},
+                                   end, known_only, false);
+  });
+  return work;
+}
+
+/**
+ * @brief 壁を1枚ずつ反転させる山登りで，展開数が最大の迷路を探す関数
+ * @details スタート区画の壁は変えない．展開数が同じなら移動を受け入れる
+ */
+Maze Climb(const Maze &maze, const bool known_only, const bool simple,
+           const int iterations) {
+  std::mt19937 rng(0);
+  Maze best = maze;
+  int best_expansions = Count(best, known_only, simple).expansions;
+  for (int n = 0; n < iterations; ++n) {
+    const auto i = WallIndex(index_t(rng() % WallIndex::SIZE));
+    if (i.getPosition() == best.getStart() ||
+        i.getPosition().next(i.getDirection()) == best.getStart())
+      continue;
+    Maze next = best;
+    next.setWall(i, !next.isWall(i));
+    next.setKnown(i, true);
+    const int expansions = Count(next, known_only, simple).expansions;
+    if (expansions >= best_expansions)
+      best = next, best_expansions = expansions;
+  }
+  return best;
+}
+
+/**
+ * @brief 迷路ファイルの1辺の区画数を，1行目の長さから求める関数
+ */
+int GetMazeSize(const std::string &file_path) {
+  std::ifstream ifs(file_path);
+  std::string line;
+  while (std::getline(ifs, line))
+    if (!line.empty())
+      return (line.size() - 1) / 4;
+  return 0;
+}
+
+/**
+ * @brief 迷路ファイルまたはそれを含むディレクトリから迷路を読み込む関数
+ * @details MAZE_SIZE より大きい迷路は読み飛ばす
+ */
+void LoadMazes(const std::string &path,
+               std::vector<std::pair<std::string, Maze>> &mazes) {
+  std::vector<std::string> files;
+  if (DIR *dir = opendir(path.c_str())) {
+    while (const auto *entry = readdir(dir)) {
+      const std::string name = entry->d_name;
+      if (name.size() > 5 && name.substr(name.size() - 5) == ".maze")
+        files.push_back(path + "/" + name);
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+  } else {
+    files.push_back(path);
+  }
+  for (const auto &file : files) {
+    const auto size = GetMazeSize(file);
+    if (size < 1 || size > MAZE_SIZE)
+      continue;
+    Maze maze;
+    if (maze.parse(file))
+      mazes.push_back({file.substr(file.find_last_of('/') + 1), maze});
+  }
+}
+
+/**
+ * @brief main 関数
+ */
+int main(int argc, char *argv[]) {
+  /* 引数の解析 */
+  int iterations = 10000;
+  std::vector<std::string> maze_paths;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "-n") && i + 1 < argc)
+      iterations = std::atoi(argv[++i]);
+    else
+      maze_paths.push_back(argv[i]);
+  }
+  if (maze_paths.empty())
+    maze_paths.push_back("../mazedata/data");
+  /* 迷路データ */
+  std::vector<std::pair<std::string, Maze>> mazes;
+  for (const auto &path : maze_paths)
+    LoadMazes(path, mazes);
+  const auto corpus_count = mazes.size();
+  /* 生成した迷路．壁を一部だけ既知にしたものを含む */
+  const char *style_names[] = {"perfect", "braided", "straight", "diagonal"};
+  for (int style = 0; style < 4; ++style)
+    for (int seed = 0; seed < 8; ++seed)
+      for (const int known_percent : {0, 50, 100}) {
+        MazeGenerator generator(seed);
+        MazeGenerator::Config config;
+        config.style = MazeGenerator::Style(style);
+        Maze maze_target, maze;
+        generator.generate(maze_target, config);
+        maze.setGoals(maze_target.getGoals());
+        for (coord_t x = 0; x < MAZE_SIZE; ++x)
+          for (coord_t y = 0; y < MAZE_SIZE; ++y)
+            for (const auto d : {Direction::East, Direction::North})
+              if (int(generator.random(100)) < known_percent)
+                maze.updateWall(Position(x, y), d,
+                                maze_target.isWall(x, y, d));
+        mazes.push_back({std::string("generated-") + style_names[style] +
+                             "-" + std::to_string(seed) + "-" +
+                             std::to_string(known_percent) + "%",
+                         maze});
+      }
+  std::printf("%d mazes (%d from files), MAZE_SIZE: %d, queue capacity: %d\n",
+              int(mazes.size()), int(corpus_count), MAZE_SIZE,
+              StepQueue::CAPACITY);
+  /* 既知壁のみかどうかと台形加速の有無の組ごとの最大値 */
+  bool overflow = false;
+  for (const bool known_only : {false, true})
+    for (const bool simple : {false, true}) {
+      std::printf("\nknown_only: %d, simple: %d\n", known_only, simple);
+      Work max;
+      size_t arg_expansions = 0, arg_update = 0, arg_step_down = 0;
+      for (size_t m = 0; m < mazes.size(); ++m) {
+        const auto w = Evaluate(mazes[m].second, known_only, simple);
+        if (w.expansions > max.expansions)
+          max.expansions = w.expansions, arg_expansions = m;
+        if (w.update_us > max.update_us)
+          max.update_us = w.update_us, arg_update = m;
+        if (w.step_down_us > max.step_down_us)
+          max.step_down_us = w.step_down_us, arg_step_down = m;
+        max.queue_peak = std::max(max.queue_peak, w.queue_peak);
+      }
+      std::printf("  %-22s %10d  %s\n", "expansions", max.expansions,
+                  mazes[arg_expansions].first.c_str());
+      std::printf("  %-22s %10d  (capacity %d)\n", "queue length",
+                  max.queue_peak, StepQueue::CAPACITY);
+      std::printf("  %-22s %10.2f  %s\n", "update [us]", max.update_us,
+                  mazes[arg_update].first.c_str());
+      std::printf("  %-22s %10.2f  %s\n", "step down [us]", max.step_down_us,
+                  mazes[arg_step_down].first.c_str());
+      /* 展開数が最大の迷路から山登り */
+      const auto climbed = Climb(mazes[arg_expansions].second, known_only,
+                                 simple, iterations);
+      const auto w = Evaluate(climbed, known_only, simple);
+      std::printf("  after %d iterations of hill climbing:\n", iterations);
+      std::printf("  %-22s %10d\n", "expansions", w.expansions);
+      std::printf("  %-22s %10d\n", "queue length", w.queue_peak);
+      std::printf("  %-22s %10.2f\n", "update [us]", w.update_us);
+      overflow |= std::max(max.queue_peak, w.queue_peak) > StepQueue::CAPACITY;
+    }
+  return overflow ? -1 : 0;
+}
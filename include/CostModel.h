@@ -0,0 +1,104 @@
+/**
+ * @file CostModel.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 最短経路導出に用いる走行時間のコストモデル
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+
+#include <algorithm> /*< for std::min */
+
+namespace MazeLib {
+
+/**
+ * @brief 台形加速を考慮した直線走行のコストモデル
+ *
+ * 走行パラメータはすべて整数で与え，コストは整数演算のみで算出する．
+ * コンパイル時に生成したテーブルと，実行時に読み込んだパラメータから
+ * 生成したテーブルは，環境によらずビット単位で一致する．
+ */
+struct CostModel {
+  uint32_t vs = 420;       /**< @brief 基本速度 [mm/s] */
+  uint32_t am = 4200;      /**< @brief 最大加速度 [mm/s/s] */
+  uint32_t vm = 1500;      /**< @brief 飽和速度 [mm/s] */
+  uint32_t seg = 90;       /**< @brief 区画の長さ [mm] */
+  uint32_t t_slalom = 287; /**< @brief 小回り90度ターンの時間 [ms] */
+  uint32_t scaling = 2;    /**< @brief コストの最大値を抑える除数 */
+
+  /**
+   * @brief 直線区間のコストテーブル．添字は直線の区画数．[0] は使用しない
+   */
+  struct Table {
+    uint16_t table[MAZE_SIZE]; /**< @brief コスト */
+    constexpr uint16_t operator[](const int i) const { return table[i]; }
+  };
+
+  /**
+   * @brief 整数の平方根 (切り捨て)
+   */
+  static constexpr uint64_t isqrt(const uint64_t x) {
+    uint64_t r = 0;
+    uint64_t bit = uint64_t(1) << 62;
+    while (bit > x)
+      bit >>= 2;
+    uint64_t rem = x;
+    while (bit) {
+      if (rem >= r + bit) {
+        rem -= r + bit;
+        r = (r >> 1) + bit;
+      } else {
+        r >>= 1;
+      }
+      bit >>= 2;
+    }
+    return r;
+  }
+  /**
+   * @brief 停止せずに i 区画を加減速して走行する時間 [ms] (切り捨て)
+   *
+   * 速度 vs から加速し，vm で飽和したのち vs まで減速する．
+   * 最大速度に達しない場合は三角加速となる．
+   * 平方根は 2^16 倍した値で求めて小数部の精度を保つ．
+   */
+  constexpr uint32_t calcStraightTime(const int i) const {
+    const uint64_t d = uint64_t(seg) * i; /*< 走行距離 [mm] */
+    const uint64_t dv2 = uint64_t(vm) * vm - uint64_t(vs) * vs;
+    if (d * am < dv2) {
+      /* 三角加速: t = 2 * (sqrt(vs^2 + am * d) - vs) / am */
+      const uint64_t root = isqrt((uint64_t(vs) * vs + am * d) << 16);
+      return uint32_t(2000 * (root - (uint64_t(vs) << 8)) /
+                      (uint64_t(am) << 8));
+    }
+    /* 台形加速: t = (am * d + (vm - vs)^2) / (am * vm) */
+    return uint32_t((am * d + uint64_t(vm - vs) * (vm - vs)) * 1000 /
+                    (uint64_t(am) * vm));
+  }
+  /**
+   * @brief 直線区間のコストテーブルを生成する関数
+   *
+   * i 区画の直線のコストは，ターン1回分の時間と i-1 区画の直線の時間の和を
+   * scaling で割った値とする．16 bit を超える場合は飽和させる．
+   */
+  constexpr Table makeTable() const {
+    Table t{};
+    for (int i = 1; i < MAZE_SIZE; ++i)
+      t.table[i] = uint16_t(std::min<uint64_t>(
+          (t_slalom + calcStraightTime(i - 1)) / scaling, UINT16_MAX));
+    return t;
+  }
+  /**
+   * @brief 空白区切りの "名前 値" の組からパラメータを読み込む関数
+   * @details 未指定のパラメータは変更しない
+   * @return true: 成功，false: 失敗
+   */
+  bool parse(std::istream &is);
+
+  /**
+   * @brief 既定のパラメータによるコンパイル時生成のコストテーブル
+   */
+  static const Table DefaultTable;
+};
+
+} // namespace MazeLib
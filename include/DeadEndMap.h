@@ -0,0 +1,103 @@
+/**
+ * @file DeadEndMap.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 経路になり得ない袋小路の区画を管理するクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 袋小路と封鎖領域の区画を管理するクラス
+ *
+ * 未知壁を壁なしとした迷路上で，スタート区画やゴール区画を含まない
+ * 袋小路 (枝分かれした行き止まりの木構造) と，スタート区画とゴール区画の
+ * どちらからも到達できない封鎖領域の区画を「袋小路」として印をつける．
+ * 袋小路の区画は，その中に始点か目的地がない限り経路上に現れない．
+ *
+ * - 全区画の再計算は，update()
+ * - 壁を更新するたびの差分更新は，updateWall()
+ * - 袋小路かどうかの確認は，isDeadEnd()
+ */
+class DeadEndMap {
+public:
+  /**
+   * @brief コンストラクタ．袋小路なしで初期化する
+   */
+  DeadEndMap() { reset(); }
+  /**
+   * @brief 袋小路なしに初期化する関数
+   */
+  void reset();
+  /**
+   * @brief 全区画の袋小路を再計算する関数
+   * @param maze 迷路．スタート区画とゴール区画は袋小路としない
+   */
+  void update(const Maze &maze);
+  /**
+   * @brief 壁の更新を反映する関数
+   *
+   * 壁ありと判明した場合は差分更新を行う．
+   * 壁なしとみなしていた壁が壁ありになった場合のみ袋小路は増える．
+   * 壁ありとみなしていた壁が未知壁に戻された場合は再計算となる．
+   * 同じ壁について何度呼んでもよい．
+   * @param maze 更新後の迷路
+   * @param i 更新された壁
+   */
+  void updateWall(const Maze &maze, const WallIndex i);
+  /**
+   * @brief 袋小路かどうかを返す
+   * @details 盤面外なら true を返す
+   */
+  bool isDeadEnd(const Position p) const {
+    return !p.isInsideOfField() || dead[p.getIndex()];
+  }
+  /**
+   * @brief 袋小路の区画の数を返す
+   */
+  size_t count() const { return dead.count(); }
+  /**
+   * @brief 経路探索で進入してよい区画の集合を取得する関数
+   *
+   * 袋小路でない区画に加えて，引数の区画から袋小路の出口までの区画を含む．
+   * @param sources 始点区画や目的地区画など，袋小路内にあり得る区画
+   */
+  std::bitset<Position::SIZE>
+  getEnterableCells(const Positions &sources) const;
+  /**
+   * @brief 袋小路としない区画 (スタートとゴール) を取得
+   */
+  const Positions &getProtectedCells() const { return protected_cells; }
+
+protected:
+  std::bitset<Position::SIZE> dead;   /**< @brief 袋小路の区画 */
+  std::bitset<WallIndex::SIZE> wall;  /**< @brief 反映済みの壁 */
+  /** @brief 袋小路の出口方向．封鎖領域の場合は Direction::Max */
+  std::array<int8_t, Position::SIZE> exit;
+  /** @brief 袋小路でない隣接区画の数 */
+  std::array<int8_t, Position::SIZE> degree;
+  /** @brief 袋小路としない区画 */
+  Positions protected_cells;
+
+  /**
+   * @brief 次数が1以下の区画を再帰的に袋小路にする関数
+   * @param stack 確認する区画の集合．関数内で消費される．
+   */
+  void peel(Positions &stack);
+  /**
+   * @brief スタート区画とゴール区画から到達できない区画を袋小路にする関数
+   * @details 到達できるかは袋小路によらず壁のみで判定し，到達できない
+   *          袋小路の出口もなくす．新たな袋小路の隣接区画の次数を減らして，
+   *          行き止まりになった区画も袋小路にする
+   */
+  void seal();
+  /**
+   * @brief 袋小路としない区画かどうか
+   */
+  bool isProtected(const Position p) const;
+};
+
+} // namespace MazeLib
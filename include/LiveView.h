@@ -0,0 +1,113 @@
+/**
+ * @file LiveView.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 端末上で差分のみを描画するステップマップのアニメーション表示
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "MazeRenderer.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace MazeLib {
+
+/**
+ * @brief 前回のフレームとの差分のみを端末に送るアニメーション表示クラス
+ *
+ * - 最初のフレームは画面を消去して全体を描画する
+ * - 以降は変化した壁や区画のみをカーソル移動のエスケープシーケンスで描画する
+ * - 目標のフレームレートを超える描画要求は描画せずに捨てる
+ *   (最後のフレームは force で描画する)
+ */
+class LiveView : protected MazeRenderer {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param fps 目標のフレームレート [Hz]．0 以下なら制限しない
+   * @param color true: ANSI エスケープシーケンスで色付けする
+   */
+  LiveView(const float fps = 30, const bool color = getColorDefault())
+      : MazeRenderer(color) {
+    setFps(fps);
+  }
+  using MazeRenderer::getBuffer;
+  using MazeRenderer::isColor;
+  /**
+   * @brief 色付けの設定．次のフレームは全体を描画する
+   */
+  void setColor(const bool color) { MazeRenderer::setColor(color), reset(); }
+  /**
+   * @brief 目標のフレームレートの設定
+   * @param fps 目標のフレームレート [Hz]．0 以下なら制限しない
+   */
+  void setFps(const float fps) {
+    period = fps > 0 ? std::chrono::duration_cast<clock::duration>(
+                           std::chrono::duration<float>(1 / fps))
+                     : clock::duration::zero();
+  }
+  /**
+   * @brief 次のフレームで画面全体を描画させる関数
+   */
+  void reset() { last_frame.clear(), has_drawn = false; }
+  /**
+   * @brief 現在姿勢付きのステップマップの描画
+   * @param p 現在区画
+   * @param d 現在区画に向かう方向
+   * @param status 迷路の下に表示する1行の文字列
+   * @param force true: フレームレートによらず描画する
+   * @return true: 描画した，false: フレームレートの制限により描画しなかった
+   */
+  bool draw(const Maze &maze, const StepMap &step_map, const Position &p,
+            const Direction d, const std::string &status,
+            std::ostream &os = std::cout, const bool force = false) {
+    return draw(maze, step_map, {d}, p.next(d + Direction::Back), status, os,
+                force);
+  }
+  /**
+   * @brief 経路付きのステップマップの描画
+   * @param dirs 移動方向の配列
+   * @param start 経路の始点区画
+   */
+  bool draw(const Maze &maze, const StepMap &step_map, const Directions &dirs,
+            const Position &start, const std::string &status,
+            std::ostream &os = std::cout, const bool force = false);
+  /**
+   * @brief これまでに描画したフレームの数
+   */
+  size_t getFrameCount() const { return frame_count; }
+
+protected:
+  using clock = std::chrono::steady_clock; /**< @brief 時計の型 */
+  /**
+   * @brief 画面上の1要素
+   */
+  struct Glyph {
+    const char *esc; /**< @brief 色．nullptr なら色なし */
+    char str[4];     /**< @brief 文字列 (終端文字を含む) */
+    int16_t row;     /**< @brief 画面上の行 (0 始まり) */
+    int16_t col;     /**< @brief 画面上の列 (0 始まり) */
+    bool operator!=(const Glyph &g) const;
+  };
+  std::vector<Glyph> frame;      /**< @brief 描画中のフレーム */
+  std::vector<Glyph> last_frame; /**< @brief 端末に表示中のフレーム */
+  int16_t row = 0;               /**< @brief 描画中の行 */
+  int16_t col = 0;               /**< @brief 描画中の列 */
+  clock::duration period;        /**< @brief フレームの最小間隔 */
+  clock::time_point last_time;   /**< @brief 最後に描画した時刻 */
+  bool has_drawn = false;        /**< @brief 画面全体を描画済みか */
+  size_t frame_count = 0;        /**< @brief 描画したフレームの数 */
+
+  /**
+   * @brief 描画の要素をフレームに記録する関数
+   */
+  void put(const char *esc, const char *str) override;
+  /**
+   * @brief 要素を色付きでバッファに追加する関数
+   */
+  void emit(const Glyph &g);
+};
+
+} // namespace MazeLib
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <type_traits> /*< for std::conditional */
 #include <vector>
 
 /**
@@ -19,10 +20,16 @@
  */
 namespace MazeLib {
 
+/**
+ * @brief 迷路の1辺の区画数の設定値．コンパイル時に -D で変更できる．
+ */
+#ifndef MAZE_SIZE_CONFIG
+#define MAZE_SIZE_CONFIG 16
+#endif
 /**
  * @brief 迷路の1辺の区画数の定数．
  */
-static constexpr int MAZE_SIZE = 16;
+static constexpr int MAZE_SIZE = MAZE_SIZE_CONFIG;
 /**
  * @brief 少数部分の切り上げ関数．
  */
@@ -35,6 +42,20 @@ static constexpr int MAZE_SIZE_BIT = ceil(std::log2(MAZE_SIZE));
  * @brief 迷路の1辺の区画数の最大値．2のbit数乗の値．
  */
 static constexpr int MAZE_SIZE_MAX = std::pow(2, MAZE_SIZE_BIT);
+/**
+ * @brief 大きな迷路の構成かどうか．
+ *
+ * 区画の座標を 8 bit (WallRecord では 6 bit) で表せない大きさの場合，
+ * 座標を 16 bit，ステップを 32 bit として扱う．
+ * Position などの大きさは 2 倍になる．
+ */
+static constexpr bool MAZE_LARGE = MAZE_SIZE_MAX > 32;
+/** @brief 区画の座標成分の型 */
+using coord_t = std::conditional<MAZE_LARGE, int16_t, int8_t>::type;
+/** @brief 区画の座標成分の符号なしの型．範囲判定の高速化に用いる */
+using ucoord_t = std::make_unsigned<coord_t>::type;
+/** @brief 区画や壁の通し番号の型．Position などのデータ全体の型を兼ねる */
+using index_t = std::conditional<MAZE_LARGE, uint32_t, uint16_t>::type;
 
 /*
  * 迷路のカラー表示切替
@@ -205,10 +226,10 @@ public:
 public:
   union {
     struct {
-      int8_t x; /**< @brief 迷路区画のx座標成分 */
-      int8_t y; /**< @brief 迷路区画のy座標成分 */
+      coord_t x; /**< @brief 迷路区画のx座標成分 */
+      coord_t y; /**< @brief 迷路区画のy座標成分 */
     };
-    uint16_t data; /**< データ全体へのアクセス用 */
+    index_t data; /**< データ全体へのアクセス用 */
   };
 
 public:
@@ -220,14 +241,14 @@ public:
    * @brief コンストラクタ
    * @param x,y 初期化パラメータ
    */
-  Position(const int8_t x, const int8_t y) : x(x), y(y) {}
+  Position(const coord_t x, const coord_t y) : x(x), y(y) {}
   /**
    * @brief 迷路内の区画の一意な通し番号となるIDを取得する
    *
    * 迷路外の区画の場合未定義動作となる．use Position::isInsideOfField()
-   * @return uint16_t 通し番号ID
+   * @return index_t 通し番号ID
    */
-  uint16_t getIndex() const { return (x << MAZE_SIZE_BIT) | y; }
+  index_t getIndex() const { return (x << MAZE_SIZE_BIT) | y; }
   /** @brief 加法 */
   Position operator+(const Position p) const {
     return Position(x + p.x, y + p.y);
@@ -251,7 +272,9 @@ public:
    * @param d 隣接方向
    * @return 隣接区画の座標
    */
-  Position next(const Direction d) const;
+  Position next(const Direction d) const {
+    return Position(x + NextX[d], y + NextY[d]);
+  }
   /**
    * @brief フィールド内かどうかを判定する関数
    * @return true フィールド内
@@ -260,8 +283,8 @@ public:
   bool isInsideOfField() const {
     // return x >= 0 && x < MAZE_SIZE && y >= 0 && y < MAZE_SIZE;
     /* 高速化 */
-    return (static_cast<uint8_t>(x) < MAZE_SIZE) &&
-           (static_cast<uint8_t>(y) < MAZE_SIZE);
+    return (static_cast<ucoord_t>(x) < MAZE_SIZE) &&
+           (static_cast<ucoord_t>(y) < MAZE_SIZE);
   }
   /**
    * @brief 座標を回転変換する
@@ -276,8 +299,14 @@ public:
    * @brief stream での表示． (  x,  y) の形式
    */
   friend std::ostream &operator<<(std::ostream &os, const Position p);
+
+private:
+  /** @brief 方向ごとの隣接区画への座標の差．添字は Direction */
+  static constexpr int8_t NextX[Direction::Max] = {1, 1, 0, -1, -1, -1, 0, 1};
+  static constexpr int8_t NextY[Direction::Max] = {0, 1, 1, 1, 0, -1, -1, -1};
 };
-static_assert(sizeof(Position) == 2, "size error"); /**< @brief size check */
+/** @brief size check */
+static_assert(sizeof(Position) == sizeof(index_t), "size error");
 
 /**
  * @brief Position 構造体の動的配列，集合
@@ -322,7 +351,7 @@ public:
 /**
  * @brief 区画ベースではなく，壁ベースの管理ID
  *
- * uint16_t にキャストすると，全部の壁が通し番号になったIDを取得できるのが特徴
+ * index_t にキャストすると，全部の壁が通し番号になったIDを取得できるのが特徴
  * 迷路内部の壁の総数 WallIndex::SIZE 個の配列を確保しておけば，
  * 取得したIDをインデックスとして使える．そのとき， WallIndex が
  * 迷路の内部にあるかどうか確認すること．(配列の範囲外アクセス防止)
@@ -359,11 +388,11 @@ struct WallIndex {
 public:
   union {
     struct {
-      int8_t x;      /**< @brief 区画座標のx成分 */
-      int8_t y : 7;  /**< @brief 区画座標のy成分 */
-      uint8_t z : 1; /**< @brief 区画内の壁の位置．0:East, 1:North */
+      coord_t x;                           /**< @brief 区画座標のx成分 */
+      coord_t y : sizeof(coord_t) * 8 - 1; /**< @brief 区画座標のy成分 */
+      ucoord_t z : 1; /**< @brief 区画内の壁の位置．0:East, 1:North */
     };
-    uint16_t data; /**< データ全体へのアクセス用 */
+    index_t data; /**< データ全体へのアクセス用 */
   };
 
 public:
@@ -374,7 +403,7 @@ public:
   /**
    * @brief 成分を受け取ってそのまま格納するコンストラクタ
    */
-  WallIndex(const int8_t x, const int8_t y, const uint8_t z)
+  WallIndex(const coord_t x, const coord_t y, const uint8_t z)
       : x(x), y(y), z(z) {}
   /**
    * @brief 表現の冗長性を除去して格納するコンストラクタ
@@ -389,7 +418,7 @@ public:
    * @param i 壁の通し番号ID．迷路内の壁であること．
    *          迷路外の壁の場合未定義動作となる．
    */
-  WallIndex(const uint16_t i)
+  WallIndex(const index_t i)
       : x(i & (MAZE_SIZE_MAX - 1)),
         y((i >> MAZE_SIZE_BIT) & (MAZE_SIZE_MAX - 1)),
         z(i >> (2 * MAZE_SIZE_BIT)) {}
@@ -406,9 +435,9 @@ public:
   /**
    * @brief 迷路内の壁を一意な通し番号として表現したIDを返す．
    *        迷路外の壁の場合未定義動作となる．
-   * @return uint16_t ID
+   * @return index_t ID
    */
-  uint16_t getIndex() const {
+  index_t getIndex() const {
     return (z << (2 * MAZE_SIZE_BIT)) | (y << MAZE_SIZE_BIT) | x;
   }
   /** @brief 位置の取得 */
@@ -435,15 +464,18 @@ public:
     //          (z == 0 && (x == MAZE_SIZE - 1)) ||
     //          (z == 1 && (y == MAZE_SIZE - 1)));
     /* 高速化 */
-    return (static_cast<uint8_t>(x) < MAZE_SIZE - 1 + z) &&
-           (static_cast<uint8_t>(y) < MAZE_SIZE - z);
+    return (static_cast<ucoord_t>(x) < MAZE_SIZE - 1 + z) &&
+           (static_cast<ucoord_t>(y) < MAZE_SIZE - z);
   }
   /**
    * @brief 引数方向の WallIndex を取得する関数
    * @param d 隣接方向
    * @return const WallIndex 隣接壁
    */
-  WallIndex next(const Direction d) const;
+  WallIndex next(const Direction d) const {
+    /* 斜め方向では East と North の壁が入れ替わる */
+    return WallIndex(x + NextX[z][d], y + NextY[z][d], z ^ (d & 1));
+  }
   /**
    * @brief 現在壁に隣接する，柱ではない6方向を取得
    * @return const std::array<Direction, 6>
@@ -477,36 +509,113 @@ private:
       break;
     }
   }
+  /** @brief 方向ごとの隣接壁への座標の差．添字は [z][Direction] */
+  static constexpr int8_t NextX[2][Direction::Max] = {
+      {1, 1, 0, 0, -1, 0, 0, 1},
+      {1, 0, 0, -1, -1, -1, 0, 0},
+  };
+  static constexpr int8_t NextY[2][Direction::Max] = {
+      {0, 0, 1, 0, 0, -1, -1, -1},
+      {0, 1, 1, 1, 0, 0, -1, 0},
+  };
+};
+/** @brief size check */
+static_assert(sizeof(WallIndex) == sizeof(index_t), "size error");
+
+/**
+ * @brief 区画と4方位から，隣接区画と壁の通し番号を引く表
+ *
+ * - 添字は区画の Position::getIndex() と4方位の番号 (Direction / 2)
+ * - 盤面外への移動と外周の壁は OUTSIDE とする．壁が OUTSIDE でなければ
+ *   隣接区画も盤面内なので，ステップマップの展開では壁だけを確認すればよい
+ * - 迷路の大きさごとにコンパイル時に生成し，全体で共有する
+ */
+struct NeighborTable {
+  /** @brief 盤面外を表す値 */
+  static constexpr index_t OUTSIDE = index_t(-1);
+  /** @brief 隣接区画の通し番号 */
+  index_t cell[Position::SIZE][4];
+  /** @brief 区画の4方位の壁の通し番号 */
+  index_t wall[Position::SIZE][4];
+
+  /**
+   * @brief 表を生成する関数
+   */
+  static constexpr NeighborTable make() {
+    NeighborTable t{};
+    for (int x = 0; x < MAZE_SIZE_MAX; ++x)
+      for (int y = 0; y < MAZE_SIZE_MAX; ++y) {
+        const int i = (x << MAZE_SIZE_BIT) | y;
+        for (int k = 0; k < 4; ++k) {
+          /* Along4 の順 (East, North, West, South) */
+          const int nx = x + (k == 0) - (k == 2);
+          const int ny = y + (k == 1) - (k == 3);
+          const bool inside = x < MAZE_SIZE && y < MAZE_SIZE && 0 <= nx &&
+                              nx < MAZE_SIZE && 0 <= ny && ny < MAZE_SIZE;
+          /* 壁は West, South を隣接区画の East, North として表す */
+          const int wx = k == 2 ? nx : x, wy = k == 3 ? ny : y, wz = k & 1;
+          t.cell[i][k] = inside ? index_t((nx << MAZE_SIZE_BIT) | ny) : OUTSIDE;
+          t.wall[i][k] = inside ? index_t((wz << (2 * MAZE_SIZE_BIT)) |
+                                          (wy << MAZE_SIZE_BIT) | wx)
+                                : OUTSIDE;
+        }
+      }
+    return t;
+  }
+  /**
+   * @brief コンパイル時生成の共有の表
+   */
+  static const NeighborTable Table;
 };
-static_assert(sizeof(WallIndex) == 2, "size error"); /**< @brief size check */
 
 /**
  * @brief WallIndex の動的配列，集合
  */
 using WallIndexes = std::vector<WallIndex>;
 
+/**
+ * @brief ビット列の真の要素の添字を昇順に走査する関数
+ * @details libstdc++ では語単位で探索する拡張 (_Find_first, _Find_next)
+ *          を使い，それ以外の標準ライブラリでは1要素ずつ調べる
+ * @param f 添字 (size_t) を受け取る関数
+ */
+template <size_t N, typename F>
+inline void forEachSetBit(const std::bitset<N> &bits, const F &f) {
+#if defined(__GLIBCXX__)
+  for (auto i = bits._Find_first(); i < N; i = bits._Find_next(i))
+    f(i);
+#else
+  for (size_t i = 0; i < N; ++i)
+    if (bits[i])
+      f(i);
+#endif
+}
+
 /**
  * @brief 区画位置，方向，壁の有無を保持する構造体．
  *
  * - 探索の記録などに用いる
  * - サイズを小さくするためにビットフィールド構造体を用いている
- * - 実体は 16bit の整数
+ * - 実体は 16bit の整数 (大きな迷路の構成では 32bit)
  */
 struct WallRecord {
+  /** @brief 座標成分の bit 数 */
+  static constexpr int COORD_BITS = sizeof(index_t) * 8 / 2 - 2;
+
   union {
     struct {
-      int x : 6;          /**< @brief 区画のx座標 */
-      int y : 6;          /**< @brief 区画のy座標 */
+      int x : COORD_BITS; /**< @brief 区画のx座標 */
+      int y : COORD_BITS; /**< @brief 区画のy座標 */
       unsigned int d : 3; /**< @brief 壁の方向 */
       unsigned int b : 1; /**< @brief 壁の有無 */
     } __attribute__((__packed__));
-    uint16_t data; /**< データ全体へのアクセス用 */
+    index_t data; /**< データ全体へのアクセス用 */
   };
   /**
    * @brief コンストラクタ
    */
   WallRecord() {}
-  WallRecord(const int8_t x, const int8_t y, const Direction d, const bool b)
+  WallRecord(const coord_t x, const coord_t y, const Direction d, const bool b)
       : x(x), y(y), d(d), b(b) {}
   WallRecord(const Position p, const Direction d, const bool b)
       : x(p.x), y(p.y), d(d), b(b) {}
@@ -517,7 +626,8 @@ struct WallRecord {
   /** @brief 表示 */
   friend std::ostream &operator<<(std::ostream &os, const WallRecord &obj);
 };
-static_assert(sizeof(WallRecord) == 2, "size error"); /**< @brief size check */
+/** @brief size check */
+static_assert(sizeof(WallRecord) == sizeof(index_t), "size error");
 
 /**
  * @brief WallRecord 構造体の動的配列の定義
@@ -525,32 +635,147 @@ static_assert(sizeof(WallRecord) == 2, "size error"); /**< @brief size check */
 using WallRecords = std::vector<WallRecord>;
 
 /**
- * @brief 迷路の壁情報を管理するクラス
+ * @brief 容量が固定のリングバッファによる壁ログ
  *
- * - 壁情報とスタート位置とゴール位置の集合などを保持する
- * - 壁の有無の確認は，isWall()
- * - 壁の既知未知の確認は，isKnown()
- * - 壁の更新は，updateWall() によって行う
+ * - 領域は setCapacity() でのみ確保し，追加や削除では再確保しない
+ * - 添字 [0, size()) は保持している記録の古い順
+ * - 記録には通し番号を振り，保持している記録は [getBegin(), getEnd())
+ *   の番号を持つ．読み手は反映済みの番号を覚えておけば差分を読める
+ * - clear() や Maze::compactWallRecords() で履歴が書き換えられた場合や，
+ *   pop_back() で巻き戻された場合，drop() で記録を捨てた場合は，番号を1つ
+ *   空けて振り直す．反映済みの番号が getBegin() 未満になるので，読み手は
+ *   全体を読み直す必要があることがわかる．巻き戻しの後に追加されても
+ *   番号は再利用されない
  */
-class Maze {
+class WallRecordLog {
 public:
   /**
-   * @brief デフォルトコンストラクタ
-   * @param goals ゴール区画の集合
-   * @param start スタート区画
+   * @brief 容量が一杯のときに記録を追加した場合の方針
    */
-  Maze(const Positions &goals = Positions(),
-       const Position start = Position(0, 0))
-      : goals(goals), start(start) {
-    reset();
+  enum OverflowPolicy : uint8_t {
+    /**
+     * @brief 古い半分の記録を，その時点の迷路を再現する最小の記録に圧縮する．
+     * 新しい記録は時系列の順に残す．入らなければ全体を圧縮し，
+     * それでも入らなければ上書きする
+     */
+    Compact,
+    OverwriteOldest, /**< @brief 最も古い記録を上書きする */
+    DropNewest,      /**< @brief 追加する記録を捨てる */
+  };
+  /**
+   * @brief 既定の容量．迷路内の壁の総数なので，Compact の方針では圧縮すれば
+   * 必ず入り，上書きされない．壁ログの不要な迷路の複製には MazeView を使う
+   */
+  static constexpr size_t DefaultCapacity = WallIndex::SIZE;
+
+public:
+  /**
+   * @brief コンストラクタ．容量分の領域を確保する
+   */
+  WallRecordLog(const size_t capacity = DefaultCapacity,
+                const OverflowPolicy policy = Compact)
+      : buffer(capacity), policy(policy) {}
+  /**
+   * @brief 容量と方針の変更．記録は消去される
+   */
+  void setCapacity(const size_t capacity, const OverflowPolicy policy) {
+    buffer.assign(capacity, WallRecord());
+    this->policy = policy;
+    clear();
   }
+  size_t capacity() const { return buffer.size(); }
+  OverflowPolicy getOverflowPolicy() const { return policy; }
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == buffer.size(); }
   /**
-   * @brief 迷路の初期化．壁を削除し，スタート区画を既知に
-   * @param set_start_wall スタート区画の East と North の壁を設定するかどうか
-   * @param set_range_full 高速化用の min_x, max_x を予め最大に設定するかどうか
+   * @brief 保持している記録の取得．添字 0 が最も古い
    */
-  void reset(const bool set_start_wall = true,
-             const bool set_range_full = false);
+  const WallRecord &operator[](const size_t i) const {
+    return buffer[(head + i) % buffer.size()];
+  }
+  /**
+   * @brief 保持している最も古い記録の通し番号
+   */
+  size_t getBegin() const { return end - count; }
+  /**
+   * @brief 次に追加される記録の通し番号
+   */
+  size_t getEnd() const { return end; }
+  /**
+   * @brief 方針によらず捨てた記録の数
+   */
+  size_t getDroppedCount() const { return dropped; }
+  /**
+   * @brief 記録の追加．容量が一杯なら最も古い記録を上書きする
+   */
+  void push_back(const WallRecord &record) {
+    if (buffer.empty())
+      return drop();
+    if (full())
+      head = (head + 1) % buffer.size(), --count, ++dropped;
+    buffer[(head + count++) % buffer.size()] = record;
+    ++end;
+  }
+  /**
+   * @brief 最も新しい記録の削除．保持している記録の番号を1つ空けて振り直す
+   */
+  void pop_back() {
+    if (count)
+      --count, end += count + 1;
+  }
+  /**
+   * @brief 記録の消去．通し番号を1つ空ける
+   */
+  void clear() {
+    head = count = 0;
+    ++end;
+  }
+  /**
+   * @brief 新しい keep 個の記録を残し，その前に n 個の記録の領域を空ける
+   * @details 空けた領域は set() で古い順に埋める．n + keep は容量以下とする．
+   *          履歴が書き換えられるので，通し番号を1つ空けて振り直す
+   */
+  void rebase(const size_t keep, const size_t n) {
+    const auto kept = (head + count - keep) % buffer.size();
+    head = (kept + buffer.size() - n) % buffer.size();
+    count = n + keep;
+    end += count + 1;
+  }
+  /**
+   * @brief 保持している記録の書き換え．添字 0 が最も古い
+   */
+  void set(const size_t i, const WallRecord &record) {
+    buffer[(head + i) % buffer.size()] = record;
+  }
+  /**
+   * @brief 記録を捨てたことの計上．保持している記録の番号を1つ空けて振り直す
+   */
+  void drop() {
+    ++dropped;
+    end += count + 1;
+  }
+
+private:
+  std::vector<WallRecord> buffer; /**< @brief 記録の領域 */
+  OverflowPolicy policy;          /**< @brief 容量が一杯のときの方針 */
+  size_t head = 0;                /**< @brief 最も古い記録の位置 */
+  size_t count = 0;               /**< @brief 保持している記録の数 */
+  size_t end = 0;                 /**< @brief 次の記録の通し番号 */
+  size_t dropped = 0;             /**< @brief 捨てた記録の数 */
+};
+
+/**
+ * @brief 迷路の壁情報のみを保持する軽量な複製
+ *
+ * - 壁と既知未知のビット列，既知壁の範囲のみを持ち，動的確保を伴わない
+ * - Maze はこのクラスを継承するので，`MazeView view = maze;` で
+ *   ゴール区画や壁ログを複製せずに壁情報を取り出せる
+ * - 仮の壁を置いた経路の評価や，並列の評価のための複製に用いる
+ * - StepMap の経路導出は MazeView を受け付ける
+ */
+class MazeView {
+public:
   /**
    * @brief 壁の有無を返す
    * @return true: 壁あり，false: 壁なし
@@ -559,7 +784,7 @@ public:
   bool isWall(const Position p, const Direction d) const {
     return isWallBase(wall, WallIndex(p, d));
   }
-  bool isWall(const int8_t x, const int8_t y, const Direction d) const {
+  bool isWall(const coord_t x, const coord_t y, const Direction d) const {
     return isWallBase(wall, WallIndex(Position(x, y), d));
   }
   /**
@@ -572,7 +797,7 @@ public:
   void setWall(const Position p, const Direction d, const bool b) {
     return setWallBase(wall, WallIndex(p, d), b);
   }
-  void setWall(const int8_t x, const int8_t y, const Direction d,
+  void setWall(const coord_t x, const coord_t y, const Direction d,
                const bool b) {
     return setWallBase(wall, WallIndex(Position(x, y), d), b);
   }
@@ -584,7 +809,7 @@ public:
   bool isKnown(const Position p, const Direction d) const {
     return isWallBase(known, WallIndex(p, d));
   }
-  bool isKnown(const int8_t x, const int8_t y, const Direction d) const {
+  bool isKnown(const coord_t x, const coord_t y, const Direction d) const {
     return isWallBase(known, WallIndex(Position(x, y), d));
   }
   /**
@@ -597,7 +822,7 @@ public:
   void setKnown(const Position p, const Direction d, const bool b) {
     return setWallBase(known, WallIndex(p, d), b);
   }
-  void setKnown(const int8_t x, const int8_t y, const Direction d,
+  void setKnown(const coord_t x, const coord_t y, const Direction d,
                 const bool b) {
     return setWallBase(known, WallIndex(Position(x, y), d), b);
   }
@@ -609,6 +834,86 @@ public:
   bool canGo(const Position p, const Direction d) const {
     return canGo(WallIndex(p, d));
   }
+  /**
+   * @brief 引数区画の壁の数を返す
+   * @param p 区画の座標
+   * @return 壁の数 0~4
+   */
+  int8_t wallCount(const Position p) const;
+  /**
+   * @brief 引数区画に隣接する未知壁の数を返す
+   * @param p 区画の座標
+   * @return 既知壁の数 0~4
+   */
+  int8_t unknownCount(const Position p) const;
+  /**
+   * @brief 壁情報と既知未知情報のビット列を取得．添字は WallIndex::getIndex()
+   */
+  const std::bitset<WallIndex::SIZE> &getWallBits() const { return wall; }
+  const std::bitset<WallIndex::SIZE> &getKnownBits() const { return known; }
+  /**
+   * @brief 既知部分の迷路サイズを返す．計算量を減らすために使用．
+   */
+  coord_t getMinX() const { return min_x; }
+  coord_t getMinY() const { return min_y; }
+  coord_t getMaxX() const { return max_x; }
+  coord_t getMaxY() const { return max_y; }
+
+protected:
+  std::bitset<WallIndex::SIZE> wall;  /**< @brief 壁情報 */
+  std::bitset<WallIndex::SIZE> known; /**< @brief 壁の既知未知情報 */
+  coord_t min_x = MAZE_SIZE - 1;      /**< @brief 既知壁の最小区画 */
+  coord_t min_y = MAZE_SIZE - 1;      /**< @brief 既知壁の最小区画 */
+  coord_t max_x = 0;                  /**< @brief 既知壁の最大区画 */
+  coord_t max_y = 0;                  /**< @brief 既知壁の最大区画 */
+
+  /**
+   * @brief 壁の確認のベース関数．迷路外を参照すると壁ありと返す．
+   */
+  bool isWallBase(const std::bitset<WallIndex::SIZE> &wall,
+                  const WallIndex i) const {
+    return !i.isInsideOfField() || wall[i.getIndex()]; //< 範囲外は壁ありに
+  }
+  /**
+   * @brief 壁の更新のベース関数．迷路外を参照しても無視される．
+   */
+  void setWallBase(std::bitset<WallIndex::SIZE> &wall, const WallIndex i,
+                   const bool b) const {
+    if (i.isInsideOfField()) //< 範囲外アクセスの防止
+      wall[i.getIndex()] = b;
+  }
+};
+/** @brief 複製に動的確保を伴わないことの確認 */
+static_assert(std::is_trivially_copyable<MazeView>::value, "not trivial");
+
+/**
+ * @brief 迷路の壁情報を管理するクラス
+ *
+ * - MazeView の壁情報に加えて，スタート位置とゴール位置の集合，
+ *   壁ログなどを保持する
+ * - 壁の有無の確認は，isWall()
+ * - 壁の既知未知の確認は，isKnown()
+ * - 壁の更新は，updateWall() によって行う
+ */
+class Maze : public MazeView {
+public:
+  /**
+   * @brief デフォルトコンストラクタ
+   * @param goals ゴール区画の集合
+   * @param start スタート区画
+   */
+  Maze(const Positions &goals = Positions(),
+       const Position start = Position(0, 0))
+      : goals(goals), start(start) {
+    reset();
+  }
+  /**
+   * @brief 迷路の初期化．壁を削除し，スタート区画を既知に
+   * @param set_start_wall スタート区画の East と North の壁を設定するかどうか
+   * @param set_range_full 高速化用の min_x, max_x を予め最大に設定するかどうか
+   */
+  void reset(const bool set_start_wall = true,
+             const bool set_range_full = false);
   /**
    * @brief 既知の壁情報と照らしあわせながら，壁を更新する関数
    *        既知の壁と非一致した場合，未知壁にして return する
@@ -621,21 +926,11 @@ public:
                   const bool pushLog = true);
   /**
    *  @brief 直前に更新した壁を見探索状態にリセットする
+   *  @details 壁ログの記録を新しい順に取り出し，壁情報の変化を取り消す．
+   *           壁ログに残っていない古い壁の情報は変更しない
    *  @param num リセットする壁の数
    */
   void resetLastWalls(const int num);
-  /**
-   * @brief 引数区画の壁の数を返す
-   * @param p 区画の座標
-   * @return 壁の数 0~4
-   */
-  int8_t wallCount(const Position p) const;
-  /**
-   * @brief 引数区画に隣接する未知壁の数を返す
-   * @param p 区画の座標
-   * @return 既知壁の数 0~4
-   */
-  int8_t unknownCount(const Position p) const;
   /**
    * @brief 迷路の表示
    */
@@ -703,16 +998,62 @@ public:
   /**
    * @brief 壁ログを取得
    */
-  const WallRecords &getWallRecords() const { return wallRecords; }
+  const WallRecordLog &getWallRecords() const { return wallRecords; }
   /**
-   * @brief 既知部分の迷路サイズを返す．計算量を減らすために使用．
+   * @brief 壁ログの容量と，容量が一杯のときの方針の変更
+   * @details 壁ログは消去される．壁情報はそのまま
+   */
+  void setWallRecordsCapacity(const size_t capacity,
+                              const WallRecordLog::OverflowPolicy policy) {
+    wallRecords.setCapacity(capacity, policy);
+  }
+  /**
+   * @brief 壁ログを現在の迷路を再現する最小の記録に圧縮する関数
+   *
+   * 既知の壁ごとに1つの記録とする．reset() した迷路に順に updateWall()
+   * すると現在の迷路が得られる．壁ログに記録されていない mergeWalls()
+   * による壁も含まれる．既知の壁の数が容量を超える場合は何もしない．
+   * 記録は壁の通し番号の順となり時系列の順は失われるので，以降の
+   * resetLastWalls() は圧縮後に追加した記録の分までとすること．
+   * 容量が一杯のときの自動の圧縮 (WallRecordLog::Compact) は，
+   * 新しい記録を時系列の順に残す．
+   * @return true: 圧縮した，false: 容量不足
+   */
+  bool compactWallRecords();
+  /**
+   * @brief 壁情報の統合で，両方で既知の壁の有無が食い違った場合の方針
    */
-  int8_t getMinX() const { return min_x; }
-  int8_t getMinY() const { return min_y; }
-  int8_t getMaxX() const { return max_x; }
-  int8_t getMaxY() const { return max_y; }
+  enum MergePolicy : uint8_t {
+    KeepOwn,     /**< @brief 自身の壁情報を残す */
+    TakeOther,   /**< @brief 引数の迷路の壁情報を採用する */
+    MarkUnknown, /**< @brief 未知壁に戻す．updateWall() の不一致と同じ扱い */
+    PreferWall,  /**< @brief 壁ありとする．走行上の安全側 */
+  };
+  /**
+   * @brief 両方で既知かつ壁の有無が食い違う壁を求める関数
+   *
+   * ビット列の語単位の演算で求めるので，壁ログを辿るより高速である．
+   * @return 食い違う壁の集合．通し番号の昇順
+   */
+  WallIndexes getConflictWalls(const MazeView &maze) const;
+  /**
+   * @brief 他の迷路の既知壁を統合する関数
+   *
+   * 自身が未知で引数の迷路が既知の壁は，引数の迷路の値で既知とする．
+   * 両方で既知の壁の食い違いは policy に従って解決する．
+   * ビット列を一括で更新するため，壁ログには記録しない．
+   * @param maze 統合する迷路．スタート区画とゴール区画は無視する
+   * @param policy 食い違った壁の扱い
+   * @return 食い違った壁の集合．通し番号の昇順
+   */
+  WallIndexes mergeWalls(const MazeView &maze, const MergePolicy policy);
   /**
    * @brief 壁ログをファイルに追記保存する関数
+   *
+   * 前回の保存以降に壁ログが書き換えられた場合 (消去，圧縮，上書き，巻き戻し)
+   * や clear が true の場合は，現在の迷路を再現する最小の記録で書き直す．
+   * 追記で既知の壁の数と壁ログの容量の和を超える場合も書き直すので，
+   * ファイルの記録の数はこの和で抑えられる．
    */
   bool backupWallRecordsToFile(const std::string &filepath,
                                const bool clear = false);
@@ -722,32 +1063,37 @@ public:
   bool restoreWallRecordsFromFile(const std::string &filepath);
 
 protected:
-  std::bitset<WallIndex::SIZE> wall;  /**< @brief 壁情報 */
-  std::bitset<WallIndex::SIZE> known; /**< @brief 壁の既知未知情報 */
-  Positions goals;                    /**< @brief ゴール区画の集合 */
-  Position start;                     /**< @brief スタート区画 */
-  WallRecords wallRecords;            /**< @brief 更新した壁のログ */
-  int8_t min_x;                       /**< @brief 既知壁の最小区画 */
-  int8_t min_y;                       /**< @brief 既知壁の最小区画 */
-  int8_t max_x;                       /**< @brief 既知壁の最大区画 */
-  int8_t max_y;                       /**< @brief 既知壁の最大区画 */
-  size_t backup_counter; /**< @brief 壁ログバックアップのカウンタ */
+  Positions goals;         /**< @brief ゴール区画の集合 */
+  Position start;          /**< @brief スタート区画 */
+  WallRecordLog wallRecords; /**< @brief 更新した壁のログ */
+  size_t backup_counter;     /**< @brief バックアップに書いた記録の数 */
+  size_t backup_sequence;    /**< @brief バックアップ済みの壁ログの番号 */
 
   /**
-   * @brief 壁の確認のベース関数．迷路外を参照すると壁ありと返す．
+   * @brief 壁ログへの記録の追加．容量が一杯なら方針に従う
+   * @details 壁情報の更新後に呼ぶ．圧縮は更新後の迷路を反映する
    */
-  bool isWallBase(const std::bitset<WallIndex::SIZE> &wall,
-                  const WallIndex i) const {
-    return !i.isInsideOfField() || wall[i.getIndex()]; //< 範囲外は壁ありに
-  }
+  void pushWallRecord(const WallRecord &record);
   /**
-   * @brief 壁の更新のベース関数．迷路外を参照しても無視される．
+   * @brief 壁ログの古い記録を圧縮して，記録を時系列の順に追加する関数
+   *
+   * 追加する記録と新しい半分までの記録の変化を壁情報から取り消して，
+   * それ以前の迷路を既知の壁ごとに1つの記録に置き換える．
+   * 容量が足りなければ残す記録を減らす．
+   * @param record 追加する記録．壁情報には反映済みであること
+   * @return true: 圧縮して追加した，false: 容量不足
    */
-  void setWallBase(std::bitset<WallIndex::SIZE> &wall, const WallIndex i,
-                   const bool b) const {
-    if (i.isInsideOfField()) //< 範囲外アクセスの防止
-      wall[i.getIndex()] = b;
-  }
+  bool compactOlderWallRecords(const WallRecord &record);
+  /**
+   * @brief 壁ログの記録1つによる壁情報の変化を取り消す関数
+   * @return false: 記録の後に記録以外の方法で壁が変更されていて取り消せない．
+   *         このとき壁情報は変更しない
+   */
+  bool undoWallRecord(const WallRecord &record);
+  /**
+   * @brief 壁ログの記録1つを updateWall() と同様に壁情報に反映する関数
+   */
+  void redoWallRecord(const WallRecord &record);
 };
 
 } // namespace MazeLib
@@ -0,0 +1,114 @@
+/**
+ * @file MazeGenerator.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief シード値から迷路を生成するクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+
+namespace MazeLib {
+
+/**
+ * @brief シード値から再現可能な迷路を生成するクラス
+ *
+ * - 同じシード値と設定からは，環境によらず同じ迷路が生成される
+ * - 全区画がスタートから到達可能であり，全壁が既知の迷路となる
+ * - 大会規定に従い，スタート区画は (0, 0) で東壁あり北壁なし，
+ *   ゴール区画は中央の正方形で入口は1箇所，柱には壁が1枚以上つく
+ *   (ゴール区画内の柱を除く)
+ */
+class MazeGenerator {
+public:
+  /**
+   * @brief 迷路の種類
+   */
+  enum Style : uint8_t {
+    Perfect,  /**< @brief 一様な木構造．ループなし */
+    Braided,  /**< @brief 木構造の行き止まりを壊したループの多い迷路 */
+    Straight, /**< @brief 長い直線の多い木構造 */
+    Diagonal, /**< @brief 斜め走行できる階段状の区間の多い木構造 */
+  };
+  /**
+   * @brief 生成の設定
+   */
+  struct Config {
+    int maze_size = MAZE_SIZE; /**< @brief 迷路の一辺の区画数 */
+    Style style = Perfect;     /**< @brief 迷路の種類 */
+    int goal_size = 2;         /**< @brief ゴール区画の一辺の区画数 */
+    /** @brief Straight, Diagonal において傾向に従って進む確率 [%] */
+    int bias_percent = 75;
+    /** @brief Braided において行き止まりを壊す確率 [%] */
+    int braid_percent = 100;
+  };
+
+public:
+  /**
+   * @brief コンストラクタ
+   * @param seed 乱数のシード値
+   */
+  MazeGenerator(const uint64_t seed = 0) { setSeed(seed); }
+  /**
+   * @brief 乱数のシード値を設定
+   */
+  void setSeed(const uint64_t seed);
+  /**
+   * @brief 迷路の生成
+   * @param maze 生成した迷路の格納先．既存の内容は破棄される．
+   * @param config 生成の設定
+   * @return true: 成功，false: 設定が不正
+   */
+  bool generate(Maze &maze, const Config &config);
+  bool generate(Maze &maze) { return generate(maze, Config()); }
+  /**
+   * @brief 0 以上 n 未満の一様乱数を生成する
+   */
+  uint32_t random(const uint32_t n) {
+    return (uint64_t(random()) * n) >> 32;
+  }
+  /**
+   * @brief 32 bit の一様乱数を生成する (xorshift64*)
+   */
+  uint32_t random() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (state * 0x2545F4914F6CDD1DULL) >> 32;
+  }
+
+protected:
+  uint64_t state; /**< @brief 乱数の状態 */
+  int maze_size;  /**< @brief 生成中の迷路の一辺の区画数 */
+  std::bitset<Position::SIZE> east;  /**< @brief 区画の東壁 */
+  std::bitset<Position::SIZE> north; /**< @brief 区画の北壁 */
+
+  /**
+   * @brief 区画の壁の有無．迷路の外周と範囲外は壁あり
+   */
+  bool isWall(const Position p, const Direction d) const;
+  /**
+   * @brief 区画の壁を取り除く
+   */
+  void removeWall(const Position p, const Direction d);
+  /**
+   * @brief 柱につく壁の数．柱 (x, y) は区画 (x, y) の南西の角
+   */
+  int pillarWallCount(const coord_t x, const coord_t y) const;
+  /**
+   * @brief 区画の壁の数
+   */
+  int wallCount(const Position p) const;
+  /**
+   * @brief 深さ優先探索による全域木の生成
+   * @param goal ゴール区画の集合
+   */
+  void carve(const Config &config, const std::bitset<Position::SIZE> &goal);
+  /**
+   * @brief 行き止まりを壊してループを作る
+   * @param goal ゴール区画の集合
+   */
+  void braid(const Config &config, const std::bitset<Position::SIZE> &goal);
+};
+
+} // namespace MazeLib
@@ -0,0 +1,81 @@
+/**
+ * @file MazePublisher.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief スレッド間で迷路のスナップショットを受け渡すクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+
+#include <atomic>
+
+namespace MazeLib {
+
+/**
+ * @brief 迷路のスナップショットをロックなしで受け渡すトリプルバッファ
+ *
+ * 壁を更新するスレッド (書き込み側，1つ) と経路を計算するスレッド
+ * (読み出し側，1つ) の間で，迷路の一貫したスナップショットを受け渡す．
+ *
+ * - 書き込み側は publish() で迷路の壁情報を空きのバッファに複製し，
+ *   原子的な交換で最新のバッファとして公開する
+ * - 読み出し側は acquire() で最新のバッファを取得する．
+ *   取得したバッファは次の acquire() まで書き換えられない
+ * - どちらの操作も待ちが発生せず，互いをブロックしない
+ * - 複製するのは壁情報 (MazeView) とスタート・ゴールのみで，
+ *   壁ログは持たない．ゴール区画の数が増えない限り，メモリの確保は
+ *   発生しない
+ */
+class MazePublisher {
+public:
+  /**
+   * @brief スナップショット
+   */
+  struct alignas(64) Snapshot {
+    MazeView maze;           /**< @brief 壁情報 */
+    Position start;          /**< @brief スタート区画 */
+    Positions goals;         /**< @brief ゴール区画 */
+    uint32_t generation = 0; /**< @brief 公開の通し番号 */
+  };
+
+public:
+  /**
+   * @brief コンストラクタ
+   * @param maze 初期状態の迷路．世代 0 として公開される
+   */
+  MazePublisher(const Maze &maze = Maze());
+  /**
+   * @brief 迷路を公開する (書き込み側)
+   * @param maze 公開する迷路．呼び出し中のみ参照する
+   * @return 公開した世代
+   */
+  uint32_t publish(const Maze &maze);
+  /**
+   * @brief 最新のスナップショットを取得する (読み出し側)
+   * @details 返した参照は，次の acquire() の呼び出しまで有効かつ不変
+   */
+  const Snapshot &acquire();
+  /**
+   * @brief 読み出し側が未取得の新しい世代があるかどうか
+   */
+  bool hasUpdate() const { return middle.load() & FRESH; }
+
+protected:
+  /**
+   * @brief 迷路の壁情報とスタート・ゴールをバッファに複製する関数
+   */
+  static void assign(Snapshot &slot, const Maze &maze);
+
+protected:
+  static constexpr uint8_t INDEX_MASK = 0x03; /**< @brief バッファ番号 */
+  static constexpr uint8_t FRESH = 0x04; /**< @brief 未取得の印 */
+  Snapshot slots[3];                     /**< @brief バッファ */
+  uint8_t back = 0;  /**< @brief 書き込み側が所有するバッファ */
+  uint8_t front = 1; /**< @brief 読み出し側が所有するバッファ */
+  /** @brief 公開中のバッファと未取得の印．書き込み側と読み出し側で共有 */
+  alignas(64) std::atomic<uint8_t> middle;
+  uint32_t generation = 0; /**< @brief 最後に公開した世代 */
+};
+
+} // namespace MazeLib
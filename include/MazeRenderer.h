@@ -0,0 +1,113 @@
+/**
+ * @file MazeRenderer.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 迷路やステップマップを文字列に描画するクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+
+#include <string>
+
+namespace MazeLib {
+
+class StepMap;
+
+/**
+ * @brief 迷路やステップマップをバッファに描画して一度に出力するクラス
+ *
+ * - 経路は描画の前に壁ごとの重ね描き配列に展開するので，
+ *   壁ごとに経路を線形探索しない
+ * - 描画はすべて内部のバッファに行い，出力は1回の書き込みで行う
+ * - バッファは再利用されるので，同じインスタンスで繰り返し描画すると
+ *   メモリ確保が発生しない
+ * - 色付きとするかどうかは実行時に切り替えられる
+ */
+class MazeRenderer {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param color true: ANSI エスケープシーケンスで色付けする
+   */
+  MazeRenderer(const bool color = getColorDefault()) : color(color) {
+    clearOverlay();
+  }
+  virtual ~MazeRenderer() {}
+  /**
+   * @brief 色付けの設定
+   */
+  void setColor(const bool color) { this->color = color; }
+  bool isColor() const { return color; }
+  /**
+   * @brief 色付けの既定値の設定
+   * @details 既定値は MAZE_COLOR_DISABLED が定義されていれば false
+   */
+  static void setColorDefault(const bool color) { color_default = color; }
+  static bool getColorDefault() { return color_default; }
+  /**
+   * @brief パス付きの迷路の描画
+   * @param dirs 移動方向の配列
+   * @param start パスのスタート座標
+   */
+  void print(const Maze &maze, const Directions &dirs, const Position &start,
+             std::ostream &os, const int maze_size = MAZE_SIZE);
+  /**
+   * @brief 位置のハイライト付きの迷路の描画
+   * @param positions ハイライト位置s
+   */
+  void print(const Maze &maze, const Positions &positions, std::ostream &os,
+             const int maze_size = MAZE_SIZE);
+  /**
+   * @brief パス付きのステップマップの描画
+   */
+  void print(const Maze &maze, const StepMap &step_map, const Directions &dirs,
+             const Position &start, std::ostream &os,
+             const int maze_size = MAZE_SIZE);
+  /**
+   * @brief 最後に描画した文字列を取得
+   */
+  const std::string &getBuffer() const { return buffer; }
+
+protected:
+  /** @brief 重ね描き配列の一辺の長さ．外周の壁を含む */
+  static constexpr int OVERLAY_SIZE = MAZE_SIZE + 1;
+  static bool color_default; /**< @brief 色付けの既定値 */
+  bool color;                /**< @brief 色付けするかどうか */
+  std::string buffer;        /**< @brief 描画先 */
+  /** @brief 区画の西壁を通過する経路の方向．なければ Direction::Max */
+  std::array<int8_t, OVERLAY_SIZE * OVERLAY_SIZE> vertical;
+  /** @brief 区画の南壁を通過する経路の方向．なければ Direction::Max */
+  std::array<int8_t, OVERLAY_SIZE * OVERLAY_SIZE> horizontal;
+  std::bitset<Position::SIZE> highlights; /**< @brief ハイライト区画 */
+  std::bitset<Position::SIZE> goals;      /**< @brief ゴール区画 */
+
+  /**
+   * @brief 重ね描きを消去する関数
+   */
+  void clearOverlay();
+  /**
+   * @brief 経路を重ね描き配列に展開する関数
+   * @details 同じ壁を複数回通過する場合は最初の方向を描く
+   */
+  void rasterize(const Directions &dirs, const Position &start);
+  /**
+   * @brief バッファに迷路を描画する関数
+   * @param step_map nullptr でなければ区画にステップを描く
+   * @param start スタートとして描く区画
+   */
+  void render(const Maze &maze, const StepMap *step_map, const Position &start,
+              const int maze_size);
+  /**
+   * @brief 描画の要素を出力する関数
+   *
+   * render() は迷路の壁，区画，柱，改行の各要素をこの関数で順に出力する．
+   * 同じ迷路の大きさと描画の種類であれば，要素の数と順番は変わらない．
+   * 既定の実装は，色付きなら色を付けてバッファに追加する．
+   * @param esc 色の ANSI エスケープシーケンス．nullptr なら色なし
+   * @param str 表示する文字列
+   */
+  virtual void put(const char *esc, const char *str);
+};
+
+} // namespace MazeLib
@@ -0,0 +1,113 @@
+/**
+ * @file MultiAgentPlanner.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 複数のエージェントで1つの迷路を協調して探索する計画を立てるクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+#include "SearchAlgorithm.h"
+#include "StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 複数のエージェントに，共有の迷路を探索する目的区画を割り当てるクラス
+ *
+ * - 各エージェントは自身のステップマップで，現在地から各区画への距離を求める
+ * - 最短経路を確定するために確認すべき区画 (SearchAlgorithm) を優先し，
+ *   残ったエージェントには未知壁を持つその他の区画を割り当てる
+ * - 最短経路の確定は，始点からゴールまでの1本の経路の確認に律速されるため，
+ *   エージェントを増やしても短縮されにくい．全区画の探索では短縮される
+ * - 割り当てた区画の未知壁は予約され，他のエージェントは同じ未知壁を
+ *   確認しに向かわない
+ * - 各エージェントが観測した壁は merge() で共有の迷路に統合する
+ */
+class MultiAgentPlanner {
+public:
+  /**
+   * @brief 1つのエージェントへの割り当て
+   */
+  struct Assignment {
+    Position target; /**< @brief 目的区画 */
+    Directions dirs; /**< @brief 現在地から目的区画への方向列．空なら待機 */
+  };
+  /**
+   * @brief Assignment の動的配列．添字はエージェントの番号
+   */
+  using Assignments = std::vector<Assignment>;
+
+public:
+  /**
+   * @brief コンストラクタ
+   * @param maze 共有の迷路の参照
+   * @param agent_count エージェントの数
+   */
+  MultiAgentPlanner(Maze &maze, const int agent_count)
+      : maze(maze), search_algorithm(maze), step_maps(agent_count),
+        assignments(agent_count) {}
+  /**
+   * @brief エージェントが観測した壁を共有の迷路に統合する関数
+   * @param observed エージェントが観測した壁を持つ迷路
+   * @param policy 共有の迷路の既知壁と食い違った場合の扱い
+   * @return 食い違った壁の集合
+   */
+  WallIndexes merge(const Maze &observed,
+                    const Maze::MergePolicy policy = Maze::MarkUnknown);
+  /**
+   * @brief 各エージェントに目的区画を割り当てる関数
+   *
+   * 現在地からの距離が最も短いエージェントと区画の組から順に割り当てる．
+   * 確認すべき区画がエージェントより少なければ，一部は待機となる．
+   * @param positions 各エージェントの現在地．要素数はエージェントの数
+   * @param simple 台形加速を考慮しないかどうか
+   * @param full true: 袋小路以外の全区画を探索する，
+   *             false: 最短経路が確定するまで探索する
+   * @return true: 割り当てあり，false: 探索の完了または探索の余地がない
+   */
+  bool assign(const Positions &positions, const bool simple = true,
+              const bool full = false);
+  /**
+   * @brief エージェントの数
+   */
+  int getAgentCount() const { return step_maps.size(); }
+  /**
+   * @brief assign() による各エージェントへの割り当て
+   */
+  const Assignments &getAssignments() const { return assignments; }
+  /**
+   * @brief 各エージェントの経路導出に使用したステップマップ
+   */
+  const StepMap &getStepMap(const int agent) const { return step_maps[agent]; }
+  /**
+   * @brief 確認すべき区画の選定に使用する探索アルゴリズム
+   */
+  const SearchAlgorithm &getSearchAlgorithm() const {
+    return search_algorithm;
+  }
+
+protected:
+  Maze &maze;                       /**< @brief 共有の迷路 */
+  SearchAlgorithm search_algorithm; /**< @brief 確認すべき区画の選定 */
+  std::vector<StepMap> step_maps;   /**< @brief エージェントごとの StepMap */
+  Assignments assignments;          /**< @brief エージェントごとの割り当て */
+  std::bitset<WallIndex::SIZE> claimed; /**< @brief 予約済みの未知壁 */
+
+  /**
+   * @brief 区画の未知壁のうち，予約されていないものがあるかどうか
+   */
+  bool isClaimable(const Position p) const;
+  /**
+   * @brief 区画の未知壁をすべて予約する関数
+   */
+  void claim(const Position p);
+  /**
+   * @brief 待機中のエージェントに候補の区画を距離の短い順に割り当てる関数
+   * @param candidates 候補の区画の集合
+   * @param busy 割り当て済みのエージェント．割り当てると true になる
+   */
+  void assignGreedy(const Positions &candidates, std::vector<bool> &busy);
+};
+
+} // namespace MazeLib
@@ -0,0 +1,148 @@
+/**
+ * @file SearchAlgorithm.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief マイクロマウスの迷路の探索アルゴリズムを扱うクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+#include "StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 探索走行の目的地の選定などを行うクラス
+ *
+ * - 迷路への参照を保持し，探索の各段階で必要な経路計算を行う
+ * - 迷路の壁の更新は利用者が Maze::updateWall() によって行う
+ */
+class SearchAlgorithm {
+public:
+  /**
+   * @brief 未知壁と，その壁を確認することによる最短経路コストの変化量の組
+   */
+  struct WallGain {
+    WallIndex i;          /**< @brief 未知壁 */
+    StepMap::step_t gain; /**< @brief 壁ありとしたときのコスト増分 */
+  };
+  /**
+   * @brief WallGain の動的配列
+   */
+  using WallGains = std::vector<WallGain>;
+
+public:
+  /**
+   * @brief コンストラクタ
+   * @param maze 探索中の迷路の参照
+   */
+  SearchAlgorithm(const Maze &maze) : maze(maze) { dead_end.update(maze); }
+  /**
+   * @brief 最短経路上の各未知壁の価値を算出する関数
+   *
+   * 未知壁を壁なしとしたスタートからゴールへの最短経路を導出し，
+   * その経路が通過する未知壁ごとに，壁ありとした場合のコストとの差を求める．
+   * 未知壁は壁なしとして導出しているので，壁なしと判明した場合のコストは
+   * 変化しない．すなわち差が 0 の壁は，確認しても最短経路のコストを変えない．
+   * @param simple 台形加速を考慮しないかどうか
+   * @return WallGains コスト増分の降順．最短経路がない場合は空配列となる．
+   */
+  WallGains calcWallGains(const bool simple);
+  /**
+   * @brief 最短経路を確定するために確認すべき区画の集合を算出する関数
+   *
+   * コスト増分が正の未知壁に隣接する区画を目的地とする．
+   * そのような未知壁がない場合は，最短経路上の未知壁に隣接する区画とする．
+   * @param simple 台形加速を考慮しないかどうか
+   * @return Positions 確認すべき区画の集合．空なら最短経路は既知である．
+   */
+  Positions findShortestCandidates(const bool simple);
+  /**
+   * @brief 既知壁のみの最短経路が最適であるかを判定する関数
+   *
+   * 既知壁のみの最短経路のコストと，未知壁を壁なしとした最短経路のコスト
+   * (最短経路のコストの下限) を比較し，その差が epsilon 以下ならば
+   * これ以上探索しても最短経路は (epsilon を超えて) 短くならない．
+   *
+   * 各コストは前回の呼び出しからの壁ログの差分を用いて差分更新される．
+   * - 壁ありと判明した壁が未知壁を壁なしとした最短経路上になければ，
+   *   未知壁を壁なしとした最短経路は変わらない
+   * - 壁なしと判明した壁は，既知壁のみの最短経路のみを変え得る
+   * @param epsilon 許容するコストの差
+   * @param simple 台形加速を考慮しないかどうか
+   * @return true: 探索を終了してよい，false: 探索の余地がある
+   */
+  bool isShortestDetermined(const StepMap::step_t epsilon, const bool simple);
+  /**
+   * @brief スタート区画へ戻る経路を，走行中に未知壁を多く観測できるように
+   * 選ぶ関数
+   *
+   * 既知壁のみの最短経路を基準として，未知壁を壁なしとした経路を
+   * コストの低い順に k 本列挙し，コストが max_cost 以下の経路のうち，
+   * 観測できる有用な未知壁が最も多い経路を選ぶ．
+   * - 観測できる壁は，経路が進入する各区画の前と左右の壁とする
+   * - 有用な未知壁は，両側の区画が袋小路でない未知壁とする．
+   *   そのうち calcWallGains() のコスト増分が正の壁を優先する
+   * - 同じ評価なら既知壁のみの最短経路，次いでコストの低い経路を選ぶ
+   * - 既知壁のみの最短経路のコストが max_cost を超える場合はそれを返す
+   *
+   * 選んだ経路は未知壁を含み得るので，未知壁のある区画に着いたら壁を
+   * 観測し，残りの時間の余裕を max_cost として再び呼び出す．
+   * @param start 現在地の区画
+   * @param max_cost 帰還経路のコストの上限
+   * @param k 比較する経路の最大本数
+   * @param simple 台形加速を考慮しないかどうか
+   * @return スタート区画への方向列．経路がない場合は空配列となる．
+   */
+  Directions calcReturnDirections(const Position &start,
+                                  const StepMap::step_t max_cost, const int k,
+                                  const bool simple);
+  /**
+   * @brief 既知壁のみの最短経路のコストを取得．経路がなければ STEP_MAX
+   * @details isShortestDetermined() の呼び出し時点の値
+   */
+  StepMap::step_t getKnownShortestCost() const { return known_cost; }
+  /**
+   * @brief 未知壁を壁なしとした最短経路のコストを取得
+   * @details isShortestDetermined() の呼び出し時点の値
+   */
+  StepMap::step_t getOptimisticShortestCost() const {
+    return optimistic_cost;
+  }
+  /**
+   * @brief 差分更新の状態を破棄する関数
+   * @details 壁ログに残らない方法で迷路を変更した場合に呼ぶ
+   */
+  void invalidate() {
+    optimistic_valid = known_valid = false;
+    dead_end.update(maze);
+  }
+  /**
+   * @brief 経路導出に使用したステップマップの参照を取得
+   */
+  const StepMap &getStepMap() const { return step_map; }
+  /**
+   * @brief 経路導出で除外する袋小路の参照を取得
+   */
+  const DeadEndMap &getDeadEndMap() const { return dead_end; }
+
+protected:
+  const Maze &maze;    /**< @brief 探索中の迷路 */
+  StepMap step_map;    /**< @brief 経路導出に使用するステップマップ */
+  DeadEndMap dead_end; /**< @brief 経路導出で除外する袋小路 */
+  /** @brief 未知壁を壁なしとした最短経路が通過する壁の集合 */
+  std::bitset<WallIndex::SIZE> optimistic_walls;
+  StepMap::step_t optimistic_cost = StepMap::STEP_MAX; /**< @brief コスト */
+  StepMap::step_t known_cost = StepMap::STEP_MAX;      /**< @brief コスト */
+  bool optimistic_valid = false; /**< @brief optimistic_cost が最新か */
+  bool known_valid = false;      /**< @brief known_cost が最新か */
+  bool cost_simple = false;      /**< @brief 各コストの導出条件 */
+  size_t wall_records_count = 0; /**< @brief 反映済みの壁ログの番号 */
+
+  /**
+   * @brief 前回の呼び出し以降に更新された壁を差分更新に反映する関数
+   */
+  void applyWallRecords();
+};
+
+} // namespace MazeLib
@@ -0,0 +1,153 @@
+/**
+ * @file SpeculativePlanner.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 次の区画の壁の観測結果ごとに経路を先行して導出するクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+#include "StepMap.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace MazeLib {
+
+/**
+ * @brief 次の区画で観測し得る壁の組合せごとに，経路を先行して導出するクラス
+ *
+ * 探索走行では，区画に入って前・左・右の壁を確認してから
+ * StepMap::update() と StepMap::calcNextDirections() を呼ぶため，
+ * その間ロボットは減速して待つことになる．
+ * このクラスは，次の区画に向かって移動している間に，
+ * 前・左・右の壁の有無の組合せ (最大 8 通り) それぞれについて
+ * ステップマップの更新と次に進む方向の導出を並列に行っておく．
+ * 壁を確認した後は，表を引くだけで次に進む方向が得られる．
+ *
+ * - prepare() は迷路を複製して導出を依頼し，すぐに戻る
+ * - lookup() は該当する組合せの導出の完了を待ち，その結果を返す
+ * - 既知の壁は既知の値に固定され，その壁について組合せを展開しない
+ * - 導出はコンストラクタで起動した作業スレッドが行い，区画ごとに
+ *   スレッドを生成しない
+ */
+class SpeculativePlanner {
+public:
+  /**
+   * @brief 壁の有無の組合せの数 (前・左・右)
+   */
+  static constexpr int OUTCOME_SIZE = 8;
+  /**
+   * @brief 壁の組合せ1通りに対する，次に進む方向の導出結果
+   */
+  struct NextDirections {
+    Directions known;      /**< @brief 次の区画から既知区間を進む方向列 */
+    Directions candidates; /**< @brief 既知区間の最終区画から進む方向の候補 */
+    Pose end;              /**< @brief 既知区間の最終区画と方向 */
+  };
+
+public:
+  /**
+   * @brief コンストラクタ
+   * @param parallel true: 作業スレッドで組合せごとに並列に導出する，
+   *                 false: lookup() の呼び出し時に該当する組合せのみ導出する
+   */
+  SpeculativePlanner(const bool parallel = true);
+  /**
+   * @brief デストラクタ．実行中の導出の完了を待ち，作業スレッドを終了する
+   */
+  ~SpeculativePlanner();
+  /**
+   * @brief 経路の先行導出を開始する関数
+   *
+   * 前回の導出が実行中であれば，その完了を待ってから開始する．
+   * @param maze 現在の迷路．呼び出し中のみ参照する
+   * @param next 次の区画と，その区画に入るときの方向
+   * @param dest 目的地区画の集合
+   * @param known_only 既知壁のみモードかどうか
+   * @param simple 台形加速を考慮しないかどうか
+   */
+  void prepare(const Maze &maze, const Pose &next, const Positions &dest,
+               const bool known_only, const bool simple);
+  /**
+   * @brief 観測した壁の組合せに対応する導出結果を取得する関数
+   *
+   * 結果は，観測した壁を迷路に反映してから StepMap::update() と
+   * StepMap::calcNextDirections() を呼んだ場合と同じになる．
+   * prepare() で既知であった壁については，引数の値は無視される．
+   * 該当する組合せの導出がまだ始まっていなければ，呼び出し元で導出する．
+   * @return 導出結果．経路がない場合は known と candidates が空となる．
+   *         次の prepare() の呼び出しまで有効
+   */
+  const NextDirections &lookup(const bool wall_front, const bool wall_left,
+                               const bool wall_right);
+  /**
+   * @brief 最後に lookup() で引いた組合せの導出に使ったステップマップ
+   * @details 次の prepare() の呼び出しまで有効
+   */
+  const StepMap &getStepMap() const { return outcomes[looked_up].step_map; }
+  /**
+   * @brief prepare() で導出を開始した壁の組合せの数 (1 から 8)
+   */
+  int getOutcomeCount() const { return outcome_count; }
+  /**
+   * @brief prepare() で与えた次の区画と方向
+   */
+  const Pose &getPose() const { return pose; }
+  /**
+   * @brief prepare() 済みかどうか
+   */
+  bool isPrepared() const { return outcome_count > 0; }
+  /**
+   * @brief 実行中の導出の完了を待つ関数
+   */
+  void wait();
+
+protected:
+  /**
+   * @brief 壁の組合せ1通りの導出状態
+   */
+  enum State : uint8_t {
+    Idle,    /**< @brief 導出の対象外，または開始待ちを破棄した */
+    Pending, /**< @brief 導出の開始待ち */
+    Running, /**< @brief 導出中 */
+    Done,    /**< @brief 導出済み */
+  };
+  /**
+   * @brief 壁の組合せ1通りの導出の作業領域
+   */
+  struct Outcome {
+    MazeView maze;       /**< @brief 観測結果を反映した壁情報 */
+    StepMap step_map;    /**< @brief 導出に使うステップマップ */
+    NextDirections next; /**< @brief 導出結果 */
+    State state = Idle;  /**< @brief 導出状態．mutex で保護する */
+  };
+
+  bool parallel;           /**< @brief 並列に導出するかどうか */
+  Pose pose;               /**< @brief 次の区画と方向 */
+  Positions dest;          /**< @brief 目的地区画の集合 */
+  bool known_only;         /**< @brief 既知壁のみモード */
+  bool simple;             /**< @brief 台形加速を考慮しない */
+  uint8_t fixed = 0;       /**< @brief 既知の壁 (前・左・右が bit 0, 1, 2) */
+  uint8_t fixed_walls = 0; /**< @brief 既知の壁の有無 */
+  int outcome_count = 0;   /**< @brief 展開した組合せの数 */
+  int looked_up = 0;       /**< @brief 最後に lookup() で引いた組合せ */
+  Outcome outcomes[OUTCOME_SIZE]; /**< @brief 組合せごとの導出状態 */
+  std::mutex mutex;               /**< @brief 導出状態の排他制御 */
+  std::condition_variable requested; /**< @brief 導出の依頼の通知 */
+  std::condition_variable finished;  /**< @brief 導出の完了の通知 */
+  bool stopping = false;             /**< @brief 作業スレッドの終了要求 */
+  std::vector<std::thread> workers;  /**< @brief 作業スレッド */
+
+  /**
+   * @brief 作業スレッドの本体．開始待ちの組合せを取り出して導出する
+   */
+  void work();
+  /**
+   * @brief 壁の組合せ1通りの導出を実行する関数
+   */
+  void run(Outcome &outcome);
+};
+
+} // namespace MazeLib
@@ -6,25 +6,139 @@
  */
 #pragma once
 
+#include "CostModel.h"
+#include "DeadEndMap.h"
 #include "Maze.h"
 #include <limits> /*< for std::numeric_limits */
+#include <memory> /*< for std::unique_ptr */
 
 namespace MazeLib {
 
+/**
+ * @brief ステップの更新予約のキュー．区画の通し番号を先入れ先出しで保持する
+ *
+ * 予約中の区画は重複させないので，長さは全区画数 Position::SIZE を
+ * 超えない．固定長のリングバッファに収まり，動的なメモリ確保をしない．
+ * 予約中の区画のステップが下がっても，取り出したときの値で展開すればよい．
+ */
+class StepQueue {
+public:
+  /** @brief 容量．予約中の区画は重複しないので全区画数 */
+  static constexpr int CAPACITY = Position::SIZE;
+
+public:
+  /** @brief 予約がないかどうか */
+  bool empty() const { return count == 0; }
+  /** @brief 予約中の区画の数 */
+  int size() const { return count; }
+  /** @brief 全予約の破棄 */
+  void clear() { head = count = 0, queued.reset(); }
+  /**
+   * @brief 区画の予約．予約中なら何もしない
+   */
+  void push(const index_t i) {
+    if (queued[i])
+      return;
+    queued[i] = true;
+    buffer[(head + count++) % CAPACITY] = i;
+  }
+  /**
+   * @brief 最も古い予約の取り出し．空でないこと
+   */
+  index_t pop() {
+    const auto i = buffer[head];
+    head = (head + 1) % CAPACITY, --count;
+    queued[i] = false;
+    return i;
+  }
+
+protected:
+  std::array<index_t, CAPACITY> buffer; /**< @brief リングバッファ */
+  std::bitset<CAPACITY> queued;         /**< @brief 予約中の区画 */
+  int head = 0;                         /**< @brief 先頭の添字 */
+  int count = 0;                        /**< @brief 予約中の区画の数 */
+};
+
 /**
  * @brief 足立法のためのステップマップを管理するクラス
  */
 class StepMap {
 public:
-  using step_t = uint16_t; /**< @brief ステップの型 */
+  /** @brief ステップの型．大きな迷路の構成では 32 bit */
+  using step_t = std::conditional<MAZE_LARGE, uint32_t, uint16_t>::type;
   static constexpr step_t STEP_MAX =
       std::numeric_limits<step_t>::max(); /**< @brief 最大ステップ値 */
+  /**
+   * @brief ステップの飽和加算
+   * @return a + b．STEP_MAX 以上になる場合は STEP_MAX (到達不能と同じ扱い)
+   */
+  static step_t addStep(const step_t a, const step_t b) {
+    return a < STEP_MAX - b ? a + b : STEP_MAX;
+  }
+  /**
+   * @brief 経路候補．方向列と推定コストの組
+   */
+  struct Route {
+    Directions dirs;   /**< @brief 始点からの移動方向列 */
+    step_t cost;       /**< @brief 経路の推定コスト */
+    int unknown_count; /**< @brief 経路上の未知壁の数 */
+  };
+  /**
+   * @brief 経路候補の動的配列
+   */
+  using Routes = std::vector<Route>;
+  /**
+   * @brief ステップマップの更新の実装の種類
+   */
+  enum Backend : uint8_t {
+    /** @brief 更新予約のキューによる更新．壁の多い迷路に向く */
+    Queue,
+    /**
+     * @brief 行と列の一括緩和を収束まで繰り返す更新．開けた迷路に向く
+     *
+     * 各列 (または転置した各行) の全区画をベクトルとして，
+     * 直線区間のコストを加えた要素ごとの min を取る．
+     * コストの増分が一定となる長さ以上の直線は，前方・後方の累積 min で扱う．
+     * 直線の打ち切りをしないので，Queue 以下のステップとなる．
+     * simple == true のときは Queue と一致する．
+     */
+    Sweep,
+  };
+  /**
+   * @brief 進行方向の候補の優先順位の付け方
+   */
+  enum CandidateOrder : uint8_t {
+    StraightFirst, /**< @brief 直進，未知壁のある区画，コストの低い順 */
+    UnknownFirst,  /**< @brief 未知壁のある区画，コストの低い順 */
+    CostOnly,      /**< @brief コストの低い順 */
+  };
 
 public:
   /**
    * @brief コンストラクタ
+   * @param cost_table 直線区間のコストテーブル．参照を保持するので，
+   * StepMap より長く存在する必要がある．既定はコンパイル時生成の共有テーブル．
+   */
+  StepMap(const CostModel::Table &cost_table = CostModel::DefaultTable);
+  /**
+   * @brief コピーコンストラクタ．更新の作業領域は複製しない
    */
-  StepMap();
+  StepMap(const StepMap &obj);
+  /**
+   * @brief 代入演算子．更新の作業領域は複製しない
+   */
+  StepMap &operator=(const StepMap &obj);
+  /**
+   * @brief デストラクタ
+   */
+  ~StepMap();
+  /**
+   * @brief コストテーブルの変更
+   * @param cost_table 参照を保持するので，StepMap より長く存在する必要がある
+   */
+  void setCostTable(const CostModel::Table &cost_table) {
+    step_table = cost_table.table;
+  }
   /**
    * @brief ステップマップを初期化する関数
    * @param step この値で初期化する
@@ -34,7 +148,7 @@ public:
    * @brief ステップの取得
    * @details 盤面外なら `STEP_MAX` を返す
    */
-  step_t getStep(const int8_t x, const int8_t y) const {
+  step_t getStep(const coord_t x, const coord_t y) const {
     return getStep(Position(x, y));
   }
   step_t getStep(const Position p) const {
@@ -44,7 +158,7 @@ public:
    * @brief ステップの更新
    * @details 盤面外なら何もしない
    */
-  void setStep(const int8_t x, const int8_t y, const step_t step) {
+  void setStep(const coord_t x, const coord_t y, const step_t step) {
     return setStep(Position(x, y), step);
   }
   void setStep(const Position p, const step_t step) {
@@ -77,8 +191,29 @@ public:
    * @param known_only true:未知壁は通過不可能，false:未知壁は通過可能とする
    * @param simple 台形加速を考慮せず，隣接区画のコストをすべて1にする
    */
-  void update(const Maze &maze, const Positions &dest, const bool known_only,
-              const bool simple);
+  void update(const MazeView &maze, const Positions &dest,
+              const bool known_only, const bool simple,
+              const Backend backend = Queue) {
+    return updateImpl(maze, dest, known_only, simple, nullptr, backend);
+  }
+  /**
+   * @brief 袋小路の区画を除外したステップマップの更新
+   *
+   * 袋小路の区画は，始点区画または目的地区画から袋小路の出口までの区画を
+   * 除いて展開しない．展開されない区画のステップは STEP_MAX となるが，
+   * start から dest への最短経路は除外しない場合と変わらない．
+   * @param dead_end 迷路に対して更新済みの袋小路
+   * @param start 経路を導出する始点区画
+   */
+  void update(const MazeView &maze, const Positions &dest,
+              const bool known_only, const bool simple,
+              const DeadEndMap &dead_end, const Position &start,
+              const Backend backend = Queue) {
+    auto sources = dest;
+    sources.push_back(start);
+    const auto enterable = dead_end.getEnterableCells(sources);
+    return updateImpl(maze, dest, known_only, simple, &enterable, backend);
+  }
   /**
    * @brief 与えられた区画間の最短経路を導出する関数
    * @param maze 迷路の参照
@@ -88,9 +223,17 @@ public:
    * @return const Directions スタートからゴールへの最短経路の方向列．
    *                    経路がない場合は空配列となる．
    */
-  Directions calcShortestDirections(const Maze &maze, const Position &start,
+  Directions calcShortestDirections(const MazeView &maze, const Position &start,
                                     const Positions &dest,
                                     const bool known_only, const bool simple);
+  /**
+   * @brief 袋小路の区画を除外して最短経路を導出する関数
+   * @param dead_end 迷路に対して更新済みの袋小路
+   */
+  Directions calcShortestDirections(const MazeView &maze, const Position &start,
+                                    const Positions &dest,
+                                    const bool known_only, const bool simple,
+                                    const DeadEndMap &dead_end);
   /**
    * @brief スタートからゴールまでの最短経路を導出する関数
    */
@@ -99,25 +242,48 @@ public:
     return calcShortestDirections(maze, maze.getStart(), maze.getGoals(),
                                   known_only, simple);
   }
+  /**
+   * @brief 与えられた区画間の経路をコストの低い順に k 本導出する関数
+   *
+   * Yen のアルゴリズムにより，互いに異なる単純経路を列挙する．
+   * 部分経路の探索にはステップマップをヒューリスティックとした A*
+   * 探索を用いる．ステップマップは dest に対して更新される．
+   * @param k 導出する経路の最大本数
+   * @return const Routes コストの昇順 (同コストなら未知壁の少ない順)
+   *                      の経路候補．経路がない場合は空配列となる．
+   */
+  Routes calcKShortestRoutes(const MazeView &maze, const Position &start,
+                             const Positions &dest, const int k,
+                             const bool known_only, const bool simple);
+  /**
+   * @brief 方向列の推定コストを算出する関数
+   *
+   * 直線区間ごとにコストテーブルの値を加算する．
+   * update() で得られるステップと同じ尺度となる．
+   */
+  step_t calcRouteCost(const Directions &dirs, const bool simple) const;
   /**
    * @brief ステップマップから次に行くべき方向を計算する関数
    * @return 既知区間の最終区画
    */
-  Pose calcNextDirections(const Maze &maze, const Pose &start,
+  Pose calcNextDirections(const MazeView &maze, const Pose &start,
                           Directions &nextDirectionsKnown,
-                          Directions &nextDirectionCandidates) const;
+                          Directions &nextDirectionCandidates,
+                          const CandidateOrder order = StraightFirst) const;
   /**
    * @brief ステップマップにより次に行くべき方向列を生成する
    */
-  Directions getStepDownDirections(const Maze &maze, const Pose &start,
+  Directions getStepDownDirections(const MazeView &maze, const Pose &start,
                                    Pose &end, const bool known_only,
                                    const bool break_unknown) const;
   /**
    * @brief 引数区画の周囲の未知壁の確認優先順位を生成する関数
+   * @param order 優先順位の付け方
    * @return const Directions 行くべき方向の優先順位
    */
-  Directions getNextDirectionCandidates(const Maze &maze,
-                                        const Pose &focus) const;
+  Directions
+  getNextDirectionCandidates(const MazeView &maze, const Pose &focus,
+                             const CandidateOrder order = StraightFirst) const;
   /**
    * @brief ゴール区画内を行けるところまで直進させる方向列を追加する関数
    * @param maze 迷路の参照
@@ -130,15 +296,64 @@ public:
                                        const bool diag_enabled);
 
 protected:
+  friend class StepMapDual; /*< 2つのステップマップを同時に更新する */
   std::array<step_t, Position::SIZE> step_map; /**< @brief ステップ数*/
-  /** @brief 台形加速を考慮したコストテーブル (壁沿い) */
-  std::array<step_t, MAZE_SIZE> step_table;
-
+  /** @brief 台形加速を考慮したコストテーブル (壁沿い)．全区画数で添字 */
+  const uint16_t *step_table;
+  /** @brief Backend::Sweep の作業領域 (StepMap.cpp で定義) */
+  struct SweepBuffer;
+  /** @brief Backend::Sweep の作業領域．初回の使用時に確保する */
+  std::unique_ptr<SweepBuffer> sweep_buffer;
+  /** @brief Backend::Queue の更新予約のキュー．初回の使用時に確保する */
+  std::unique_ptr<StepQueue> queue;
+  /**
+   * @brief 更新予約のキューの取得．大きな迷路ではスタックに収まらないので，
+   * StepMap ごとに確保する．更新の終了時には常に空である
+   */
+  StepQueue &getQueue();
+  /**
+   * @brief ステップマップの更新の実装
+   * @param enterable 展開する区画の集合．nullptr なら全区画
+   */
+  void updateImpl(const MazeView &maze, const Positions &dest,
+                  const bool known_only, const bool simple,
+                  const std::bitset<Position::SIZE> *enterable,
+                  const Backend backend = Queue);
+  /**
+   * @brief 区画から4方向の直線で行ける区画のステップを緩和する関数
+   * @details Backend::Queue の更新の1区画分の処理
+   * @param focus 注目する区画の通し番号
+   * @param enterable 展開する区画の集合．nullptr なら全区画
+   * @param q ステップを更新した区画の追加先
+   */
+  void relaxFrom(const MazeView &maze, const index_t focus,
+                 const bool known_only, const bool simple,
+                 const std::bitset<Position::SIZE> *enterable,
+                 StepQueue &q);
+  /**
+   * @brief 一括緩和によるステップマップの更新の実装 (Backend::Sweep)
+   * @param enterable 展開する区画の集合．nullptr なら全区画
+   */
+  void updateSweep(const MazeView &maze, const Positions &dest,
+                   const bool known_only, const bool simple,
+                   const std::bitset<Position::SIZE> *enterable);
   /**
-   * @brief 最短経路導出用の加速を考慮したステップリストを算出する関数
-   * 高速化のため，あらかじめ計算を終えておく．
+   * @brief Yen のアルゴリズムの部分経路を A* 探索で導出する関数
+   * @param spur 部分経路の始点姿勢．方向はそれまでの経路の最終方向
+   * @param spur_run 始点に至る直線区間の長さ．0 なら方向を考慮しない
+   * @param blocked 通過を禁止する区画の集合
+   * @param forbidden 始点から出ることを禁止する方向の集合 (Direction 順)
+   * @param is_dest 目的地区画の集合
+   * @param spur_dirs 導出した方向列の格納先
+   * @return true: 経路あり，false: 経路なし
    */
-  void calcStraightStepTable();
+  bool calcSpurDirections(const MazeView &maze, const Pose &spur,
+                          const int spur_run,
+                          const std::bitset<Position::SIZE> &blocked,
+                          const std::bitset<Direction::Max> &forbidden,
+                          const std::bitset<Position::SIZE> &is_dest,
+                          const bool known_only, const bool simple,
+                          Directions &spur_dirs) const;
 };
 
 } // namespace MazeLib
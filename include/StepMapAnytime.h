@@ -0,0 +1,80 @@
+/**
+ * @file StepMapAnytime.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 計算量の上限を指定して分割して更新できるステップマップ
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 1回の呼び出しの計算量に上限を設け，複数回に分けて更新できる
+ * ステップマップ
+ *
+ * 制御周期ごとに経路計算に使える時間が決まっている場合に使う．
+ * start() で更新を始め，resume() を制御周期ごとに呼んで続きを計算する．
+ * 更新の途中でも，calcBestDirections() により，その時点で求まっている
+ * 最良の経路が得られる．途中のステップは実際に存在する経路のコストなので，
+ * 得られる経路は目的地に至る正しい経路であり，更新が進むほど短くなる．
+ *
+ * 更新の処理は Backend::Queue と同じで，収束したステップマップは
+ * StepMap::update() の結果と一致する．ただし，更新の途中で迷路の壁を
+ * 変更してはならない．壁が変わったら start() からやり直す．
+ */
+class StepMapAnytime : public StepMap {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param cost_table 直線区間のコストテーブル．参照を保持する
+   */
+  StepMapAnytime(const CostModel::Table &cost_table = CostModel::DefaultTable)
+      : StepMap(cost_table) {}
+  /**
+   * @brief ステップマップの更新を始める関数
+   * @details 目的地のステップを0にするのみで，緩和は resume() で行う
+   * @param dest ステップを0とする目的地の区画の集合(順不同)
+   * @param known_only true:未知壁は通過不可能，false:未知壁は通過可能とする
+   * @param simple 台形加速を考慮せず，隣接区画のコストをすべて1にする
+   */
+  void start(const Positions &dest, const bool known_only, const bool simple);
+  /**
+   * @brief ステップマップの更新を続ける関数
+   * @param maze start() 以降，壁を変更していない迷路
+   * @param max_expansions 展開する区画の数の上限．1区画の展開は
+   *                       4方向の直線の緩和で，計算量の上限が決まっている
+   * @return true: 収束した，false: 未処理の区画が残っている
+   */
+  bool resume(const MazeView &maze, const int max_expansions);
+  /**
+   * @brief 更新が収束したかどうか
+   * @details 収束していれば calcBestDirections() の経路は最短経路となる
+   */
+  bool isOptimal() const { return q.empty(); }
+  /**
+   * @brief 未処理の更新予約の数の取得．StepQueue::CAPACITY を超えない
+   */
+  int getQueueSize() const { return q.size(); }
+  /**
+   * @brief start() から展開した区画の数の取得
+   */
+  int getExpansionCount() const { return expansion_count; }
+  /**
+   * @brief 現時点のステップマップで最良の経路を導出する関数
+   * @param start 始点区画
+   * @return 始点から目的地への方向列．まだ始点に経路が届いていない場合は
+   *         空配列となる．isOptimal() なら最短経路
+   */
+  Directions calcBestDirections(const MazeView &maze,
+                                const Position &start) const;
+
+protected:
+  StepQueue q;              /**< @brief 未処理の更新予約のキュー */
+  bool known_only = false;  /**< @brief 既知壁のみで更新中かどうか */
+  bool simple = false;      /**< @brief 台形加速を考慮しないかどうか */
+  int expansion_count = 0;  /**< @brief 展開した区画の数 */
+};
+
+} // namespace MazeLib
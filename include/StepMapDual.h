@@ -0,0 +1,116 @@
+/**
+ * @file StepMapDual.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 既知壁のみと未知壁を壁なしとした2つのステップマップを扱うクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 既知壁のみのステップマップと未知壁を壁なしとしたステップマップを，
+ * 1回の走査で同時に更新するクラス
+ *
+ * 探索中は同じ目的地について両方のステップマップが必要になるが，
+ * 区画の走査や壁の参照は共通である．このクラスは更新予約のキューを共有し，
+ * 各予約にどちらのマップの更新によるものかを記録して，両方を同時に更新する．
+ * 各マップの結果は StepMap::update() を個別に呼んだ場合と一致する．
+ *
+ * 更新後のマップは StepMap として参照できるので，
+ * 経路の導出など StepMap の関数がそのまま使える．
+ *
+ * 区画の走査を共有できるのは，2つのマップが同じ区画を同時に更新する場合
+ * に限られる．全壁が既知に近いほど共有が増え，未知壁が多いと
+ * 2回の StepMap::update() と同程度の計算量となる．
+ */
+class StepMapDual {
+public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+
+public:
+  /**
+   * @brief コンストラクタ
+   * @param cost_table 直線区間のコストテーブル．参照を保持する
+   */
+  StepMapDual(const CostModel::Table &cost_table = CostModel::DefaultTable)
+      : optimistic(cost_table), known(cost_table), queued_lanes() {}
+  /**
+   * @brief コストテーブルの変更
+   */
+  void setCostTable(const CostModel::Table &cost_table) {
+    optimistic.setCostTable(cost_table), known.setCostTable(cost_table);
+  }
+  /**
+   * @brief 2つのステップマップを同時に更新する関数
+   * @param dest ステップを0とする目的地の区画の集合(順不同)
+   * @param simple 台形加速を考慮せず，隣接区画のコストをすべて1にする
+   */
+  void update(const MazeView &maze, const Positions &dest, const bool simple) {
+    return updateImpl(maze, dest, simple, nullptr);
+  }
+  /**
+   * @brief 袋小路の区画を除外して2つのステップマップを同時に更新する関数
+   * @param dead_end 迷路に対して更新済みの袋小路
+   * @param start 経路を導出する始点区画
+   * @see StepMap::update()
+   */
+  void update(const MazeView &maze, const Positions &dest, const bool simple,
+              const DeadEndMap &dead_end, const Position &start) {
+    auto sources = dest;
+    sources.push_back(start);
+    const auto enterable = dead_end.getEnterableCells(sources);
+    return updateImpl(maze, dest, simple, &enterable);
+  }
+  /**
+   * @brief 2つの最短経路を同時に導出する関数
+   *
+   * StepMap::calcShortestDirections() を known_only を変えて
+   * 2回呼んだ場合と同じ結果となる．
+   * @param optimistic_dirs 未知壁を壁なしとした最短経路の格納先
+   * @param known_dirs 既知壁のみの最短経路の格納先
+   */
+  void calcShortestDirections(const MazeView &maze, const Position &start,
+                              const Positions &dest, const bool simple,
+                              const DeadEndMap &dead_end,
+                              Directions &optimistic_dirs,
+                              Directions &known_dirs);
+  /**
+   * @brief 未知壁を壁なしとしたステップマップ (known_only = false)
+   */
+  const StepMap &getOptimistic() const { return optimistic; }
+  /**
+   * @brief 既知壁のみのステップマップ (known_only = true)
+   */
+  const StepMap &getKnownOnly() const { return known; }
+  /**
+   * @brief known_only に対応するステップマップ
+   */
+  const StepMap &get(const bool known_only) const {
+    return known_only ? known : optimistic;
+  }
+
+protected:
+  StepMap optimistic; /**< @brief 未知壁を壁なしとしたステップマップ */
+  StepMap known;      /**< @brief 既知壁のみのステップマップ */
+  /** @brief 予約中の区画ごとの，更新されたマップのビット．予約がなければ 0 */
+  std::array<uint8_t, Position::SIZE> queued_lanes;
+
+  /**
+   * @brief 2つのステップマップの更新の実装
+   * @param enterable 展開する区画の集合．nullptr なら全区画
+   */
+  void updateImpl(const MazeView &maze, const Positions &dest,
+                  const bool simple,
+                  const std::bitset<Position::SIZE> *enterable);
+  /**
+   * @brief ステップマップを下って最短経路を導出する関数
+   * @return 方向列．目的地に到達しない場合は空配列
+   */
+  static Directions stepDown(const StepMap &step_map, const MazeView &maze,
+                             const Position &start, const bool known_only);
+};
+
+} // namespace MazeLib
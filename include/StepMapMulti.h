@@ -0,0 +1,98 @@
+/**
+ * @file StepMapMulti.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 複数の目的地のステップマップを同時に扱うクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 最大 LANES 個の目的地の集合について，ステップマップを
+ * 1回の走査で同時に更新するクラス
+ *
+ * 各区画は目的地ごとのステップをベクトルとして持ち，
+ * 直線区間の更新を GCC のベクトル拡張による要素ごとの min で一括して行う．
+ * x86-64 では SSE2，ARM では NEON の命令となる．
+ * ゴール区画，スタート区画，複数の候補区画などへの
+ * ステップを1回の走査で得られる．
+ *
+ * - 壁の参照は全レーンで共通なので，更新の最初に区画ごとに求めておく
+ * - simple == true のとき，各レーンは StepMap::update() と一致する
+ * - simple == false のとき，各レーンは同じコストテーブルと直線の打ち切り規則
+ *   で導出されるが，直線の打ち切りは更新の順序に依存するため，
+ *   StepMap::update() と値が一致するとは限らない．
+ *   導出される経路の到達可能性は一致し，コストもほぼ同等となる
+ */
+class StepMapMulti {
+public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+  static constexpr int LANES = 8; /**< @brief 同時に扱う目的地の集合の数 */
+  /** @brief 区画ごとの全レーンのステップ */
+  typedef step_t step_vec_t __attribute__((vector_size(sizeof(step_t) *
+                                                        LANES)));
+
+public:
+  /**
+   * @brief コンストラクタ
+   * @param cost_table 直線区間のコストテーブル．参照を保持する
+   */
+  StepMapMulti(const CostModel::Table &cost_table = CostModel::DefaultTable)
+      : step_table(cost_table.table) {
+    reset();
+  }
+  /**
+   * @brief 全レーンのステップを STEP_MAX に初期化する関数
+   */
+  void reset();
+  /**
+   * @brief 全レーンのステップマップを同時に更新する関数
+   * @param dests レーンごとの目的地区画の集合．LANES 個を超える分は無視する
+   * @param known_only true:未知壁は通過不可能，false:未知壁は通過可能とする
+   * @param simple 台形加速を考慮せず，隣接区画のコストをすべて1にする
+   */
+  void update(const MazeView &maze, const std::vector<Positions> &dests,
+              const bool known_only, const bool simple);
+  /**
+   * @brief 更新に使ったレーンの数
+   */
+  int getLaneCount() const { return lane_count; }
+  /**
+   * @brief ステップの取得
+   * @details 盤面外または範囲外のレーンなら `STEP_MAX` を返す
+   */
+  step_t getStep(const int lane, const Position p) const {
+    return p.isInsideOfField() && lane >= 0 && lane < LANES
+               ? step_map[p.getIndex()][lane]
+               : StepMap::STEP_MAX;
+  }
+  /**
+   * @brief 区画の全レーンのステップを取得
+   */
+  const step_vec_t &getSteps(const Position p) const {
+    return step_map[p.getIndex()];
+  }
+  /**
+   * @brief レーンのステップマップを StepMap に複製する関数
+   * @details StepMap の経路導出や表示の関数を使うために用いる
+   */
+  void copyLane(const int lane, StepMap &out) const;
+  /**
+   * @brief 始点からレーンの目的地への最短経路を導出する関数
+   * @param known_only update() と同じ値を与える
+   * @return 方向列．目的地に到達しない場合は空配列となる．
+   */
+  Directions calcShortestDirections(const int lane, const MazeView &maze,
+                                    const Position &start,
+                                    const bool known_only) const;
+
+protected:
+  std::array<step_vec_t, Position::SIZE> step_map; /**< @brief ステップ */
+  const uint16_t *step_table; /**< @brief 直線区間のコストテーブル */
+  int lane_count = 0;       /**< @brief 更新に使ったレーンの数 */
+};
+
+} // namespace MazeLib
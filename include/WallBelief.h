@@ -0,0 +1,95 @@
+/**
+ * @file WallBelief.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 壁の有無の確からしさを対数オッズで保持するクラス
+ * @date 2026.10.19
+ */
+#pragma once
+
+#include "Maze.h"
+#include <cstdlib> /*< for std::abs */
+
+namespace MazeLib {
+
+/**
+ * @brief 壁センサの観測を対数オッズで積算し，迷路の壁情報に反映するクラス
+ *
+ * - 壁ごとに壁ありの対数オッズを int8_t の固定小数点で保持する．
+ *   単位は自然対数の 1/16 とする (32 で約 88 % の確からしさ)
+ * - 対数オッズが正なら壁あり，絶対値が known_threshold 以上なら既知とする
+ * - update() で観測を積算し，判定が変わった壁のみ Maze::updateWall()
+ *   により迷路に反映する．StepMap や SearchAlgorithm は従来どおり
+ *   迷路の isWall() と isKnown() を参照すればよい
+ * - Maze::updateWall() は1回の食い違いで未知壁に戻すが，このクラスでは
+ *   繰り返し観測した壁は1回のセンサの誤りでは未知壁に戻らない．
+ *   食い違いによる再探索の走行を減らせる
+ */
+class WallBelief {
+public:
+  /**
+   * @brief 観測の重みと判定の閾値
+   */
+  struct Config {
+    int8_t hit = 32;             /**< @brief 壁ありの観測で加える値 */
+    int8_t miss = 32;            /**< @brief 壁なしの観測で引く値 */
+    int8_t known_threshold = 24; /**< @brief 既知とする絶対値の下限 */
+    int8_t saturation = 96;      /**< @brief 絶対値の上限 */
+  };
+
+public:
+  /**
+   * @brief コンストラクタ．全ての壁を未観測とする
+   */
+  WallBelief() { reset(); }
+  WallBelief(const Config &config) : config(config) { reset(); }
+  /**
+   * @brief 全ての壁を未観測にする関数
+   */
+  void reset() { log_odds.fill(0); }
+  /**
+   * @brief 迷路の既知の壁を確定した値として初期化する関数
+   * @details スタート区画の壁など，観測によらず既知の壁を持つ迷路に使う
+   */
+  void reset(const MazeView &maze);
+  /**
+   * @brief 観測を積算して迷路に反映する関数
+   *
+   * Maze::updateWall() の代わりに呼ぶ．
+   * @param maze 反映先の迷路
+   * @param b 観測した壁の有無
+   * @return true: 迷路の判定が観測と一致，false: 観測と食い違った
+   */
+  bool update(Maze &maze, const Position p, const Direction d, const bool b);
+  /**
+   * @brief 直前に更新した壁を未観測に戻す関数
+   *
+   * Maze::resetLastWalls() の代わりに呼ぶ．ゴールへの経路がなくなった
+   * ときなど，誤った観測を取り消すために使う．
+   * @param num リセットする壁ログの数
+   */
+  void resetLastWalls(Maze &maze, const int num);
+  /**
+   * @brief 壁ありの対数オッズの取得．迷路外の壁は上限値 (壁あり)
+   */
+  int8_t getLogOdds(const WallIndex i) const {
+    return i.isInsideOfField() ? log_odds[i.getIndex()] : config.saturation;
+  }
+  /**
+   * @brief 閾値による壁の有無と既知未知の判定．Maze と同じ意味
+   */
+  bool isWall(const WallIndex i) const { return getLogOdds(i) > 0; }
+  bool isKnown(const WallIndex i) const {
+    return std::abs(getLogOdds(i)) >= config.known_threshold;
+  }
+  /**
+   * @brief 設定の取得
+   */
+  const Config &getConfig() const { return config; }
+
+protected:
+  Config config; /**< @brief 観測の重みと判定の閾値 */
+  /** @brief 壁ありの対数オッズ．添字は WallIndex::getIndex() */
+  std::array<int8_t, WallIndex::SIZE> log_odds;
+};
+
+} // namespace MazeLib
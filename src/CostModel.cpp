@@ -0,0 +1,36 @@
+/**
+ * @file CostModel.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 最短経路導出に用いる走行時間のコストモデル
+ * @date 2026.10.19
+ */
+#include "CostModel.h"
+
+namespace MazeLib {
+
+/* コンパイル時に生成し，全 StepMap で共有する */
+static constexpr CostModel::Table default_table = CostModel().makeTable();
+const CostModel::Table CostModel::DefaultTable = default_table;
+
+bool CostModel::parse(std::istream &is) {
+  CostModel m = *this;
+  std::string key;
+  while (is >> key) {
+    uint32_t *target = key == "vs"         ? &m.vs
+                       : key == "am"       ? &m.am
+                       : key == "vm"       ? &m.vm
+                       : key == "seg"      ? &m.seg
+                       : key == "t_slalom" ? &m.t_slalom
+                       : key == "scaling"  ? &m.scaling
+                                           : nullptr;
+    if (!target || !(is >> *target))
+      return false; /*< 不明な名前 or 値の読み込み失敗 */
+  }
+  /* 0 除算となるパラメータは受け付けない */
+  if (m.am == 0 || m.vm == 0 || m.scaling == 0 || m.vm < m.vs)
+    return false;
+  *this = m;
+  return true;
+}
+
+} // namespace MazeLib
@@ -0,0 +1,164 @@
+/**
+ * @file DeadEndMap.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 経路になり得ない袋小路の区画を管理するクラス
+ * @date 2026.10.19
+ */
+#include "DeadEndMap.h"
+
+#include <algorithm> /*< for std::find */
+
+namespace MazeLib {
+
+void DeadEndMap::reset() {
+  dead.reset();
+  wall.reset();
+  exit.fill(int8_t(Direction::Max));
+  protected_cells.clear();
+  /* 壁のない迷路の次数 */
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+      const auto p = Position(x, y);
+      degree[p.getIndex()] = 0;
+      for (const auto d : Direction::Along4)
+        degree[p.getIndex()] += WallIndex(p, d).isInsideOfField();
+    }
+}
+void DeadEndMap::update(const Maze &maze) {
+  /* スタート区画とゴール区画は袋小路としない */
+  protected_cells = maze.getGoals();
+  protected_cells.push_back(maze.getStart());
+  /* 未知壁は壁なしとみなす */
+  for (int i = 0; i < WallIndex::SIZE; ++i)
+    wall[i] = maze.isWall(WallIndex(index_t(i)));
+  dead.reset();
+  exit.fill(int8_t(Direction::Max));
+  /* 到達不能な区画 */
+  seal();
+  /* 次数の算出 */
+  Positions stack;
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+      const auto p = Position(x, y);
+      degree[p.getIndex()] = 0;
+      for (const auto d : Direction::Along4) {
+        const auto i = WallIndex(p, d);
+        if (i.isInsideOfField() && !wall[i.getIndex()] &&
+            !dead[p.next(d).getIndex()])
+          ++degree[p.getIndex()];
+      }
+      if (!dead[p.getIndex()] && degree[p.getIndex()] <= 1)
+        stack.push_back(p);
+    }
+  /* 行き止まりから再帰的に袋小路とする */
+  peel(stack);
+}
+void DeadEndMap::updateWall(const Maze &maze, const WallIndex i) {
+  if (!i.isInsideOfField())
+    return;
+  const bool b = maze.isWall(i);
+  if (wall[i.getIndex()] == b)
+    return; /*< 変化なし */
+  if (!b)
+    return update(maze); /*< 通路が増えた場合は再計算 */
+  wall[i.getIndex()] = true;
+  const auto d = i.getDirection();
+  const auto p1 = i.getPosition();
+  const auto p2 = p1.next(d);
+  /* 袋小路の出口が塞がれた．奥の区画も含めて到達できなくなる */
+  if ((dead[p1.getIndex()] && exit[p1.getIndex()] == d) ||
+      (dead[p2.getIndex()] && exit[p2.getIndex()] == d + Direction::Back))
+    return seal();
+  /* 袋小路でない区画間の通路が塞がれた */
+  if (!dead[p1.getIndex()] && !dead[p2.getIndex()]) {
+    --degree[p1.getIndex()];
+    --degree[p2.getIndex()];
+    Positions stack{p1, p2};
+    peel(stack);
+    /* 迷路が分断された可能性がある．片側が袋小路になっても，
+     * その先に閉路を含む到達できない領域が残り得る */
+    seal();
+  }
+}
+std::bitset<Position::SIZE>
+DeadEndMap::getEnterableCells(const Positions &sources) const {
+  auto enterable = ~dead;
+  /* 袋小路内の区画から出口までたどる */
+  for (auto p : sources)
+    while (p.isInsideOfField() && !enterable[p.getIndex()]) {
+      enterable[p.getIndex()] = true;
+      if (exit[p.getIndex()] == Direction::Max)
+        break;
+      p = p.next(exit[p.getIndex()]);
+    }
+  return enterable;
+}
+void DeadEndMap::peel(Positions &stack) {
+  while (!stack.empty()) {
+    const auto p = stack.back();
+    stack.pop_back();
+    if (dead[p.getIndex()] || degree[p.getIndex()] > 1 || isProtected(p))
+      continue;
+    dead[p.getIndex()] = true;
+    /* 残った隣接区画が出口となる (次数は1以下) */
+    for (const auto d : Direction::Along4) {
+      const auto i = WallIndex(p, d);
+      const auto next = p.next(d);
+      if (!i.isInsideOfField() || wall[i.getIndex()] || dead[next.getIndex()])
+        continue;
+      exit[p.getIndex()] = d;
+      --degree[next.getIndex()];
+      stack.push_back(next);
+    }
+  }
+}
+void DeadEndMap::seal() {
+  if (protected_cells.empty())
+    return;
+  /* スタート区画とゴール区画から到達可能な区画を探索．袋小路も通る */
+  std::bitset<Position::SIZE> reached;
+  Positions stack;
+  for (const auto p : protected_cells)
+    if (p.isInsideOfField())
+      reached[p.getIndex()] = true, stack.push_back(p);
+  while (!stack.empty()) {
+    const auto p = stack.back();
+    stack.pop_back();
+    for (const auto d : Direction::Along4) {
+      const auto i = WallIndex(p, d);
+      const auto next = p.next(d);
+      if (!i.isInsideOfField() || wall[i.getIndex()] ||
+          reached[next.getIndex()])
+        continue;
+      reached[next.getIndex()] = true;
+      stack.push_back(next);
+    }
+  }
+  /* 到達不能な区画は，袋小路の木を含めて出口のない袋小路 */
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+      const auto p = Position(x, y);
+      if (reached[p.getIndex()])
+        continue;
+      const bool was_dead = dead[p.getIndex()];
+      dead[p.getIndex()] = true, exit[p.getIndex()] = Direction::Max;
+      if (was_dead)
+        continue;
+      /* 袋小路でない隣接区画の次数を減らし，行き止まりになれば袋小路とする */
+      for (const auto d : Direction::Along4) {
+        const auto i = WallIndex(p, d);
+        const auto next = p.next(d);
+        if (!i.isInsideOfField() || wall[i.getIndex()] || dead[next.getIndex()])
+          continue;
+        --degree[next.getIndex()];
+        stack.push_back(next);
+      }
+    }
+  peel(stack);
+}
+bool DeadEndMap::isProtected(const Position p) const {
+  return std::find(protected_cells.cbegin(), protected_cells.cend(), p) !=
+         protected_cells.cend();
+}
+
+} // namespace MazeLib
@@ -0,0 +1,96 @@
+/**
+ * @file LiveView.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 端末上で差分のみを描画するステップマップのアニメーション表示
+ * @date 2026.10.19
+ */
+#include "LiveView.h"
+
+#include <cstdio>  /*< for std::snprintf */
+#include <cstring> /*< for std::strncpy, std::strcmp */
+
+namespace MazeLib {
+
+static constexpr const char *ESC_NO = "\x1b[0m";    /*< 色の解除 */
+static constexpr const char *ESC_CLEAR = "\x1b[2J"; /*< 画面の消去 */
+static constexpr const char *ESC_EOL = "\x1b[K";    /*< 行末までの消去 */
+
+bool LiveView::Glyph::operator!=(const Glyph &g) const {
+  return esc != g.esc || std::strcmp(str, g.str) != 0;
+}
+bool LiveView::draw(const Maze &maze, const StepMap &step_map,
+                    const Directions &dirs, const Position &start,
+                    const std::string &status, std::ostream &os,
+                    const bool force) {
+  /* フレームレートの制限 (描画しない場合は時刻の取得のみ) */
+  const auto now = clock::now();
+  if (!force && has_drawn && now - last_time < period)
+    return false;
+  last_time = now;
+  /* フレームを要素の配列として描画 */
+  frame.clear();
+  row = col = 0;
+  clearOverlay();
+  rasterize(dirs, start);
+  render(maze, &step_map, start, MAZE_SIZE);
+  const auto status_row = row;
+  /* 前回のフレームとの差分をバッファに書き出す */
+  buffer.clear();
+  char cursor[32]; /*< 2つの int を含むエスケープシーケンス (27 byte) が入る */
+  const auto move = [&](const int r, const int c) {
+    std::snprintf(cursor, sizeof(cursor), "\x1b[%d;%dH", r + 1, c + 1);
+    buffer += cursor;
+  };
+  if (!has_drawn || frame.size() != last_frame.size()) {
+    /* 画面全体を描画 */
+    buffer += ESC_CLEAR;
+    move(0, 0);
+    for (const auto &g : frame)
+      emit(g);
+  } else {
+    /* 変化した要素のみを描画．連続する要素ではカーソル移動を省く */
+    int cursor_row = -1, cursor_col = -1;
+    for (size_t i = 0; i < frame.size(); ++i) {
+      const auto &g = frame[i];
+      if (!(g != last_frame[i]) || g.str[0] == '\n')
+        continue;
+      if (g.row != cursor_row || g.col != cursor_col)
+        move(g.row, g.col);
+      emit(g);
+      cursor_row = g.row;
+      cursor_col = g.col + std::strlen(g.str);
+    }
+    move(status_row, 0);
+  }
+  buffer += status;
+  buffer += ESC_EOL;
+  buffer += '\n';
+  os.write(buffer.data(), buffer.size()).flush();
+  std::swap(frame, last_frame);
+  has_drawn = true;
+  ++frame_count;
+  return true;
+}
+void LiveView::put(const char *esc, const char *str) {
+  Glyph g;
+  g.esc = esc;
+  std::strncpy(g.str, str, sizeof(g.str) - 1);
+  g.str[sizeof(g.str) - 1] = '\0';
+  g.row = row;
+  g.col = col;
+  frame.push_back(g);
+  if (str[0] == '\n')
+    ++row, col = 0;
+  else
+    col += std::strlen(g.str);
+}
+void LiveView::emit(const Glyph &g) {
+  const bool colored = g.esc && isColor();
+  if (colored)
+    buffer += g.esc;
+  buffer += g.str;
+  if (colored)
+    buffer += ESC_NO;
+}
+
+} // namespace MazeLib
@@ -5,6 +5,7 @@
  * @date 2017.10.30
  */
 #include "Maze.h"
+#include "MazeRenderer.h"
 
 #include <algorithm> //< for std::find(), std::count_if()
 #include <iomanip>   //< for std::setw()
@@ -17,29 +18,8 @@ const std::array<Direction, 4> Direction::Diag4 = {NorthEast, NorthWest,
                                                    SouthWest, SouthEast};
 
 /* Position */
-Position Position::next(const Direction d) const {
-  switch (d) {
-  case Direction::East:
-    return Position(x + 1, y);
-  case Direction::NorthEast:
-    return Position(x + 1, y + 1);
-  case Direction::North:
-    return Position(x, y + 1);
-  case Direction::NorthWest:
-    return Position(x - 1, y + 1);
-  case Direction::West:
-    return Position(x - 1, y);
-  case Direction::SouthWest:
-    return Position(x - 1, y - 1);
-  case Direction::South:
-    return Position(x, y - 1);
-  case Direction::SouthEast:
-    return Position(x + 1, y - 1);
-  default:
-    logw << d << std::endl;
-    return *this;
-  }
-}
+constexpr int8_t Position::NextX[];
+constexpr int8_t Position::NextY[];
 Position Position::rotate(const Direction d) const {
   switch (d) {
   case Direction::East:
@@ -67,34 +47,18 @@ std::ostream &operator<<(std::ostream &os, const Pose &pose) {
 }
 
 /* WallIndex */
-WallIndex WallIndex::next(const Direction d) const {
-  switch (d) {
-  case Direction::East:
-    return WallIndex(x + 1, y, z);
-  case Direction::NorthEast:
-    return WallIndex(x + (1 - z), y + z, 1 - z);
-  case Direction::North:
-    return WallIndex(x, y + 1, z);
-  case Direction::NorthWest:
-    return WallIndex(x - z, y + z, 1 - z);
-  case Direction::West:
-    return WallIndex(x - 1, y, z);
-  case Direction::SouthWest:
-    return WallIndex(x - z, y - (1 - z), 1 - z);
-  case Direction::South:
-    return WallIndex(x, y - 1, z);
-  case Direction::SouthEast:
-    return WallIndex(x + (1 - z), y - (1 - z), 1 - z);
-  default:
-    logw << d << std::endl;
-    return WallIndex(x, y, z);
-  }
-}
+constexpr int8_t WallIndex::NextX[][Direction::Max];
+constexpr int8_t WallIndex::NextY[][Direction::Max];
 std::ostream &operator<<(std::ostream &os, const WallIndex i) {
   return os << "( " << std::setw(2) << (int)i.x << ", " << std::setw(2)
             << (int)i.y << ", " << i.getDirection().toChar() << ")";
 }
 
+/* NeighborTable */
+/* コンパイル時に生成し，全 StepMap で共有する */
+static constexpr NeighborTable neighbor_table = NeighborTable::make();
+const NeighborTable NeighborTable::Table = neighbor_table;
+
 /* WallRecord */
 std::ostream &operator<<(std::ostream &os, const WallRecord &obj) {
   return os << "( " << std::setw(2) << (int)obj.x << ", " << std::setw(2)
@@ -108,20 +72,20 @@ void Maze::reset(const bool set_start_wall, const bool set_range_full) {
   known.reset();
   min_x = min_y = set_range_full ? 0 : (MAZE_SIZE - 1);
   max_x = max_y = set_range_full ? (MAZE_SIZE - 1) : 0;
-  backup_counter = 0;
+  backup_counter = backup_sequence = 0;
   if (set_start_wall) {
     updateWall(Position(0, 0), Direction::East, true);   //< start cell
     updateWall(Position(0, 0), Direction::North, false); //< start cell
   }
   wallRecords.clear();
 }
-int8_t Maze::wallCount(const Position p) const {
+int8_t MazeView::wallCount(const Position p) const {
   const auto &dirs = Direction::Along4;
   return std::count_if(dirs.cbegin(), dirs.cend(),
                        //  [&](const auto d) { return isWall(p, d); });
                        [&](const Direction d) { return isWall(p, d); });
 }
-int8_t Maze::unknownCount(const Position p) const {
+int8_t MazeView::unknownCount(const Position p) const {
   const auto &dirs = Direction::Along4;
   return std::count_if(dirs.cbegin(), dirs.cend(),
                        //  [&](const auto d) { return !isKnown(p, d); });
@@ -135,36 +99,128 @@ bool Maze::updateWall(const Position p, const Direction d, const bool b,
     setKnown(p, d, false);
     /* ログに追加 */
     if (pushLog)
-      wallRecords.push_back(WallRecord(p, d, b));
+      pushWallRecord(WallRecord(p, d, b));
     return false;
   }
   /* 未知壁なら壁情報を更新 */
   if (!isKnown(p, d)) {
     setWall(p, d, b);
     setKnown(p, d, true);
-    /* ログに追加 */
-    if (pushLog)
-      wallRecords.push_back(WallRecord(p, d, b));
     /* 最大最小区画を更新 */
     min_x = std::min(p.x, min_x);
     min_y = std::min(p.y, min_y);
     max_x = std::max(p.x, max_x);
     max_y = std::max(p.y, max_y);
+    /* ログに追加 */
+    if (pushLog)
+      pushWallRecord(WallRecord(p, d, b));
+  }
+  return true;
+}
+void Maze::pushWallRecord(const WallRecord &record) {
+  if (wallRecords.full()) {
+    switch (wallRecords.getOverflowPolicy()) {
+    case WallRecordLog::Compact:
+      /* 古い記録を圧縮し，新しい記録は時系列の順に残す */
+      if (compactOlderWallRecords(record))
+        return;
+      /* 全体の圧縮後の壁ログは更新後の迷路を再現するので，追加は不要 */
+      if (compactWallRecords())
+        return;
+      break; /*< 容量不足なら最も古い記録を上書き */
+    case WallRecordLog::OverwriteOldest:
+      break;
+    case WallRecordLog::DropNewest:
+      return wallRecords.drop();
+    }
+  }
+  wallRecords.push_back(record);
+}
+bool Maze::compactWallRecords() {
+  if (known.count() > wallRecords.capacity())
+    return false;
+  wallRecords.clear();
+  forEachSetBit(known, [&](const size_t i) {
+    const auto wi = WallIndex(index_t(i));
+    wallRecords.push_back(
+        WallRecord(wi.getPosition(), wi.getDirection(), wall[i]));
+  });
+  return true;
+}
+bool Maze::compactOlderWallRecords(const WallRecord &record) {
+  const auto capacity = wallRecords.capacity();
+  /* 追加する記録を取り消しても既知の壁の数が容量以上なら入らない */
+  if (known.count() > capacity)
+    return false;
+  /* 追加する記録と新しい半分の記録を取り消して，それ以前の迷路を求める */
+  if (!undoWallRecord(record))
+    return false;
+  size_t keep = 0;
+  while (keep < wallRecords.size() / 2 &&
+         undoWallRecord(wallRecords[wallRecords.size() - 1 - keep]))
+    ++keep;
+  /* 容量が足りなければ，取り消した記録を古い順に反映し直して残す数を減らす */
+  size_t known_count = known.count();
+  while (keep > 0 && known_count + keep + 1 > capacity) {
+    const auto &wr = wallRecords[wallRecords.size() - keep];
+    const auto i = WallIndex(wr.getPosition(), wr.getDirection());
+    const bool was_known = isKnown(i);
+    redoWallRecord(wr);
+    known_count = known_count + isKnown(i) - was_known;
+    --keep;
+  }
+  if (known_count + keep + 1 > capacity) {
+    redoWallRecord(record);
+    return false;
+  }
+  /* 残す記録の前を，それ以前の迷路を再現する最小の記録で埋める */
+  wallRecords.rebase(keep, known_count);
+  size_t n = 0;
+  forEachSetBit(known, [&](const size_t i) {
+    const auto wi = WallIndex(index_t(i));
+    wallRecords.set(n++,
+                    WallRecord(wi.getPosition(), wi.getDirection(), wall[i]));
+  });
+  /* 取り消した記録を反映し直し，追加する記録を続ける */
+  for (size_t j = 0; j < keep; ++j)
+    redoWallRecord(wallRecords[known_count + j]);
+  redoWallRecord(record);
+  wallRecords.push_back(record);
+  return true;
+}
+bool Maze::undoWallRecord(const WallRecord &record) {
+  const auto i = WallIndex(record.getPosition(), record.getDirection());
+  if (!i.isInsideOfField())
+    return true; /*< 迷路外の壁は変化しない */
+  if (!isKnown(i)) {
+    /* 既知壁との食い違いで未知壁に戻した記録 */
+    setWall(i, !record.b), setKnown(i, true);
+    return true;
   }
+  /* 未知壁を既知にした記録．記録と値が異なれば記録の後に変更されている */
+  if (isWall(i) != record.b)
+    return false;
+  setWall(i, false), setKnown(i, false);
   return true;
 }
+void Maze::redoWallRecord(const WallRecord &record) {
+  const auto i = WallIndex(record.getPosition(), record.getDirection());
+  if (isKnown(i) && isWall(i) != record.b)
+    setWall(i, false), setKnown(i, false);
+  else if (!isKnown(i))
+    setWall(i, record.b), setKnown(i, true);
+}
 void Maze::resetLastWalls(const int num) {
-  for (int i = 0; i < num && !wallRecords.empty(); ++i)
+  /* 新しい記録から順に，壁情報の変化を取り消す */
+  for (int n = 0; n < num && !wallRecords.empty(); ++n) {
+    const auto wr = wallRecords[wallRecords.size() - 1];
     wallRecords.pop_back();
-  /* 編集済みの壁情報を取得 */
-  const auto new_wallRecords = wallRecords;
-  /* スタート壁を考慮して迷路をリセット */
-  reset(isWall(getStart(), Direction::East) &&
-        isKnown(getStart(), Direction::East) &&
-        canGo(getStart(), Direction::North));
-  for (const auto wr : new_wallRecords)
-    updateWall(wr.getPosition(), wr.getDirection(), wr.b);
-  return;
+    /* 記録の後に記録以外の方法で変更された壁は未知壁にする */
+    if (!undoWallRecord(wr)) {
+      const auto i = WallIndex(wr.getPosition(), wr.getDirection());
+      setWall(i, false), setKnown(i, false);
+    }
+  }
 }
 bool Maze::parse(std::istream &is) {
   /* determine the maze size */
@@ -180,11 +236,11 @@ bool Maze::parse(std::istream &is) {
   /* reset existing maze */
   reset(), goals.clear();
   char c; //< temporal variable to use next
-  for (int8_t y = maze_size; y >= 0; --y) {
+  for (coord_t y = maze_size; y >= 0; --y) {
     /* vertiacal walls and cells */
     if (y != maze_size) {
       is.ignore(10, '|'); //< skip until next '|'
-      for (int8_t x = 0; x < maze_size; ++x) {
+      for (coord_t x = 0; x < maze_size; ++x) {
         is.ignore(1); //< skip a space
         c = is.get();
         if (c == 'S')
@@ -200,7 +256,7 @@ bool Maze::parse(std::istream &is) {
       }
     }
     /* horizontal walls and pillars */
-    for (uint8_t x = 0; x < maze_size; ++x) {
+    for (coord_t x = 0; x < maze_size; ++x) {
       is >> c; //< skip until next '+' or 'o'
       std::string s;
       for (int i = 0; i < 3; ++i)
@@ -224,10 +280,10 @@ bool Maze::parse(const std::vector<std::string> &data, const int maze_size) {
                 const std::array<Direction, 4> bit_to_dir_map{{b0, b1, b2, b3}};
                 reset(false);
                 int diffs = 0;
-                for (int8_t y = 0; y < maze_size; ++y) {
-                  for (int8_t x = 0; x < maze_size; ++x) {
-                    const int8_t xd = xr ? x : (maze_size - x - 1);
-                    const int8_t yd = yr ? y : (maze_size - y - 1);
+                for (coord_t y = 0; y < maze_size; ++y) {
+                  for (coord_t x = 0; x < maze_size; ++x) {
+                    const coord_t xd = xr ? x : (maze_size - x - 1);
+                    const coord_t yd = yr ? y : (maze_size - y - 1);
                     const char c = xy ? data[xd][yd] : data[yd][xd];
                     uint8_t h = 0;
                     if ('0' <= c && c <= '9')
@@ -259,10 +315,10 @@ bool Maze::parse(const std::vector<std::string> &data, const int maze_size) {
   return false;
 }
 void Maze::print(std::ostream &os, const int maze_size) const {
-  for (int8_t y = maze_size; y >= 0; --y) {
+  for (coord_t y = maze_size; y >= 0; --y) {
     if (y != maze_size) {
       os << '|';
-      for (int8_t x = 0; x < maze_size; ++x) {
+      for (coord_t x = 0; x < maze_size; ++x) {
         const auto p = Position(x, y);
         if (p == start)
           os << " S ";
@@ -276,7 +332,7 @@ void Maze::print(std::ostream &os, const int maze_size) const {
       }
       os << std::endl;
     }
-    for (int8_t x = 0; x < maze_size; ++x) {
+    for (coord_t x = 0; x < maze_size; ++x) {
       const auto k = isKnown(x, y, Direction::South);
       const auto w = isWall(x, y, Direction::South);
       os << '+' << (k ? (w ? "---" : "   ") : " . ");
@@ -286,115 +342,71 @@ void Maze::print(std::ostream &os, const int maze_size) const {
 }
 void Maze::print(const Directions &dirs, const Position &start,
                  std::ostream &os, const size_t maze_size) const {
-  /* preparation */
-  std::vector<Pose> path;
-  Position p = start;
-  for (const auto d : dirs)
-    path.push_back({p, d}), p = p.next(d);
-  const auto &maze = *this;
-  /* start to draw maze */
-  for (int8_t y = maze_size; y >= 0; --y) {
-    if (y != (int)maze_size) {
-      for (uint8_t x = 0; x <= maze_size; ++x) {
-        /* Vertical Wall */
-        const auto it =
-            std::find_if(path.cbegin(), path.cend(), [&](const Pose &pose) {
-              return WallIndex(pose.p, pose.d) ==
-                     WallIndex(Position(x, y), Direction::West);
-            });
-        const auto w = maze.isWall(x, y, Direction::West);
-        const auto k = maze.isKnown(x, y, Direction::West);
-        if (it != path.cend())
-          os << C_YE << it->d << C_NO;
-        else
-          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
-        /* Breaking Condition */
-        if (x == maze_size)
-          break;
-        /* Cell */
-        const auto p = Position(x, y);
-        if (p == start)
-          os << C_BL << " S " << C_NO;
-        else if (std::find(goals.cbegin(), goals.cend(), p) != goals.cend())
-          os << C_BL << " G " << C_NO;
-        else
-          os << "   ";
-      }
-      os << std::endl;
-    }
-    for (uint8_t x = 0; x < maze_size; ++x) {
-      /* Pillar */
-      os << '+';
-      /* Horizontal Wall */
-      const auto it =
-          std::find_if(path.cbegin(), path.cend(), [&](const Pose pose) {
-            return WallIndex(pose.p, pose.d) ==
-                   WallIndex(Position(x, y), Direction::South);
-          });
-      const auto w = maze.isWall(x, y, Direction::South);
-      const auto k = maze.isKnown(x, y, Direction::South);
-      if (it != path.cend())
-        os << C_YE << ' ' << it->d << ' ' << C_NO;
-      else
-        os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
-    }
-    /* Last Pillar */
-    os << '+' << std::endl;
-  }
+  MazeRenderer().print(*this, dirs, start, os, maze_size);
 }
 void Maze::print(const Positions &positions, std::ostream &os,
                  const size_t maze_size) const {
-  /* preparation */
-  const auto exists = [&](const Position &p) {
-    return std::find(positions.cbegin(), positions.cend(), p) !=
-           positions.cend();
-  };
-  const auto &maze = *this;
-  /* start to draw maze */
-  for (int8_t y = maze_size; y >= 0; --y) {
-    if (y != (int)maze_size) {
-      for (uint8_t x = 0; x <= maze_size; ++x) {
-        /* Vertical Wall */
-        const auto w = maze.isWall(x, y, Direction::West);
-        const auto k = maze.isKnown(x, y, Direction::West);
-        os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
-        /* Breaking Condition */
-        if (x == maze_size)
-          break;
-        /* Cell */
-        const auto p = Position(x, y);
-        if (p == start)
-          os << C_BL << " S " << C_NO;
-        else if (std::find(goals.cbegin(), goals.cend(), p) != goals.cend())
-          os << C_BL << " G " << C_NO;
-        else if (exists(p))
-          os << C_YE << " X " << C_NO;
-        else
-          os << "   ";
-      }
-      os << std::endl;
-    }
-    for (uint8_t x = 0; x < maze_size; ++x) {
-      /* Pillar */
-      os << '+';
-      /* Horizontal Wall */
-      const auto w = maze.isWall(x, y, Direction::South);
-      const auto k = maze.isKnown(x, y, Direction::South);
-      os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
-    }
-    /* Last Pillar */
-    os << '+' << std::endl;
+  MazeRenderer().print(*this, positions, os, maze_size);
+}
+/* ビット列の真の要素の壁の集合 */
+static WallIndexes toWallIndexes(const std::bitset<WallIndex::SIZE> &bits) {
+  WallIndexes indexes;
+  indexes.reserve(bits.count());
+  forEachSetBit(bits, [&](const size_t i) {
+    indexes.push_back(WallIndex(index_t(i)));
+  });
+  return indexes;
+}
+WallIndexes Maze::getConflictWalls(const MazeView &maze) const {
+  const auto &other_wall = maze.getWallBits();
+  const auto &other_known = maze.getKnownBits();
+  return toWallIndexes(known & other_known & (wall ^ other_wall));
+}
+WallIndexes Maze::mergeWalls(const MazeView &maze, const MergePolicy policy) {
+  const auto &other_wall = maze.getWallBits();
+  const auto &other_known = maze.getKnownBits();
+  const auto conflicts = known & other_known & (wall ^ other_wall);
+  /* 自身が未知で引数の迷路が既知の壁は，引数の迷路の値とする */
+  const auto taken = other_known & ~known;
+  wall = (wall & ~taken) | (other_wall & taken);
+  known |= other_known;
+  /* 食い違いの解決 */
+  switch (policy) {
+  case KeepOwn:
+    break;
+  case TakeOther:
+    wall ^= conflicts;
+    break;
+  case MarkUnknown:
+    wall &= ~conflicts, known &= ~conflicts;
+    break;
+  case PreferWall:
+    wall |= conflicts;
+    break;
   }
+  /* 最大最小区画を更新 */
+  min_x = std::min(min_x, maze.getMinX());
+  min_y = std::min(min_y, maze.getMinY());
+  max_x = std::max(max_x, maze.getMaxX());
+  max_y = std::max(max_y, maze.getMaxY());
+  return toWallIndexes(conflicts);
 }
 bool Maze::backupWallRecordsToFile(const std::string &filepath,
                                    const bool clear) {
   /* 変更なし */
-  if (!clear && backup_counter == wallRecords.size())
+  if (!clear && backup_sequence == wallRecords.getEnd())
     return true;
-  /* 前のデータが残っていたら削除 */
+  /* 前のデータが残っていたら，または壁ログが書き換えられていたら削除 */
   std::ifstream fs(filepath, std::ifstream::ate);
   const auto size = static_cast<size_t>(fs.tellg());
-  if (clear || size / sizeof(WallRecord) > backup_counter) {
+  const bool rewritten = backup_sequence < wallRecords.getBegin() ||
+                         backup_sequence > wallRecords.getEnd();
+  /* 追記により既知の壁の数と壁ログの容量の和を超える場合も書き直す */
+  const bool too_large =
+      backup_counter + (wallRecords.getEnd() - backup_sequence) >
+      known.count() + wallRecords.capacity();
+  if (clear || rewritten || too_large ||
+      size / sizeof(WallRecord) > backup_counter) {
     fs.close();
     std::remove(filepath.c_str());
     backup_counter = 0;
@@ -406,11 +418,21 @@ bool Maze::backupWallRecordsToFile(const std::string &filepath,
     loge << "failed to open file! " << filepath << std::endl;
     return false;
   }
-  while (backup_counter < wallRecords.size()) {
-    const auto &wr = wallRecords[backup_counter];
+  const auto write = [&](const WallRecord &wr) {
     of.write(reinterpret_cast<const char *>(&wr), sizeof(wr));
     backup_counter++;
+  };
+  if (backup_counter == 0) {
+    /* 書き直しは現在の迷路を再現する最小の記録で行う */
+    forEachSetBit(known, [&](const size_t i) {
+      const auto wi = WallIndex(index_t(i));
+      write(WallRecord(wi.getPosition(), wi.getDirection(), wall[i]));
+    });
+  } else {
+    for (auto n = backup_sequence; n < wallRecords.getEnd(); ++n)
+      write(wallRecords[n - wallRecords.getBegin()]);
   }
+  backup_sequence = wallRecords.getEnd();
   return true;
 }
 bool Maze::restoreWallRecordsFromFile(const std::string &filepath) {
@@ -419,17 +441,19 @@ bool Maze::restoreWallRecordsFromFile(const std::string &filepath) {
     loge << "failed to open file! " << filepath << std::endl;
     return false;
   }
-  backup_counter = 0;
   reset();
-  while (!f.eof()) {
-    WallRecord wr;
-    f.read(reinterpret_cast<char *>(&wr), sizeof(WallRecord));
+  WallRecord wr;
+  size_t count = 0;
+  while (f.read(reinterpret_cast<char *>(&wr), sizeof(WallRecord))) {
     Position p = Position(wr.x, wr.y);
     Direction d = Direction(wr.d);
     bool b = wr.b;
     updateWall(p, d, b);
-    backup_counter++;
+    count++;
   }
+  /* ファイルの記録は反映済み */
+  backup_counter = count;
+  backup_sequence = wallRecords.getEnd();
   return true;
 }
 
@@ -0,0 +1,198 @@
+/**
+ * @file MazeGenerator.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief シード値から迷路を生成するクラス
+ * @date 2026.10.19
+ */
+#include "MazeGenerator.h"
+
+namespace MazeLib {
+
+void MazeGenerator::setSeed(const uint64_t seed) {
+  /* splitmix64 で状態を初期化 (状態 0 を避ける) */
+  uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  state = (z ^ (z >> 31)) | 1;
+}
+bool MazeGenerator::generate(Maze &maze, const Config &config) {
+  /* 設定の確認．スタート区画とゴール区画が重ならないこと */
+  if (config.maze_size < 2 || config.maze_size > MAZE_SIZE ||
+      config.goal_size < 1 || config.goal_size > config.maze_size - 2)
+    return false;
+  maze_size = config.maze_size;
+  east.set(), north.set();
+  /* 中央のゴール区画 */
+  std::bitset<Position::SIZE> goal;
+  Positions goals;
+  const coord_t goal_min = (maze_size - config.goal_size) / 2;
+  for (coord_t x = goal_min; x < goal_min + config.goal_size; ++x)
+    for (coord_t y = goal_min; y < goal_min + config.goal_size; ++y) {
+      const auto p = Position(x, y);
+      goal[p.getIndex()] = true;
+      goals.push_back(p);
+      /* ゴール区画内の壁はなし */
+      if (x + 1 < goal_min + config.goal_size)
+        removeWall(p, Direction::East);
+      if (y + 1 < goal_min + config.goal_size)
+        removeWall(p, Direction::North);
+    }
+  /* 迷路の生成 */
+  carve(config, goal);
+  if (config.style == Braided)
+    braid(config, goal);
+  /* 迷路に反映 */
+  maze.reset(false);
+  maze.setStart(Position(0, 0));
+  maze.setGoals(goals);
+  for (coord_t x = 0; x < maze_size; ++x)
+    for (coord_t y = 0; y < maze_size; ++y)
+      for (const auto d : {Direction::East, Direction::North})
+        maze.updateWall(Position(x, y), d, isWall(Position(x, y), d), false);
+  return true;
+}
+bool MazeGenerator::isWall(const Position p, const Direction d) const {
+  const auto n = p.next(d);
+  if (p.x < 0 || p.y < 0 || p.x >= maze_size || p.y >= maze_size ||
+      n.x < 0 || n.y < 0 || n.x >= maze_size || n.y >= maze_size)
+    return true;
+  switch (d) {
+  case Direction::East:
+    return east[p.getIndex()];
+  case Direction::North:
+    return north[p.getIndex()];
+  case Direction::West:
+    return east[n.getIndex()];
+  case Direction::South:
+    return north[n.getIndex()];
+  default:
+    return true;
+  }
+}
+void MazeGenerator::removeWall(const Position p, const Direction d) {
+  const auto n = p.next(d);
+  switch (d) {
+  case Direction::East:
+    east[p.getIndex()] = false;
+    break;
+  case Direction::North:
+    north[p.getIndex()] = false;
+    break;
+  case Direction::West:
+    east[n.getIndex()] = false;
+    break;
+  case Direction::South:
+    north[n.getIndex()] = false;
+    break;
+  }
+}
+int MazeGenerator::pillarWallCount(const coord_t x, const coord_t y) const {
+  /* 柱の北，南，東，西にのびる壁 */
+  return isWall(Position(x - 1, y), Direction::East) +
+         isWall(Position(x - 1, y - 1), Direction::East) +
+         isWall(Position(x, y - 1), Direction::North) +
+         isWall(Position(x - 1, y - 1), Direction::North);
+}
+int MazeGenerator::wallCount(const Position p) const {
+  int n = 0;
+  for (const auto d : Direction::Along4)
+    n += isWall(p, d);
+  return n;
+}
+void MazeGenerator::carve(const Config &config,
+                          const std::bitset<Position::SIZE> &goal) {
+  /* 探索中の区画と，その区画に至った方向と，その前の方向 */
+  struct Frame {
+    Position p;
+    Direction d1, d2;
+  };
+  std::vector<Frame> stack;
+  stack.reserve(maze_size * maze_size);
+  std::bitset<Position::SIZE> visited;
+  bool goal_connected = false;
+  /* スタート区画は北にのみ出られる */
+  visited[Position(0, 0).getIndex()] = true;
+  visited[Position(0, 1).getIndex()] = true;
+  removeWall(Position(0, 0), Direction::North);
+  stack.push_back({Position(0, 1), Direction::North, Direction::North});
+  while (!stack.empty()) {
+    const auto f = stack.back();
+    /* 進める方向の候補．ゴール区画へは一度だけ入り，先へは進まない */
+    Direction candidates[4];
+    int count = 0;
+    bool has_d1 = false, has_d2 = false;
+    for (const auto d : Direction::Along4) {
+      const auto n = f.p.next(d);
+      if (n.x < 0 || n.y < 0 || n.x >= maze_size || n.y >= maze_size)
+        continue;
+      if (goal[n.getIndex()] ? goal_connected : visited[n.getIndex()])
+        continue;
+      candidates[count++] = d;
+      has_d1 |= d == f.d1;
+      has_d2 |= d == f.d2;
+    }
+    if (count == 0) {
+      stack.pop_back();
+      continue;
+    }
+    /* 迷路の種類に応じた方向の選択 */
+    const int k = random(count);
+    Direction d = candidates[k];
+    if (config.style == Straight && int(random(100)) < config.bias_percent) {
+      if (has_d1)
+        d = f.d1; /*< 直進 */
+    } else if (config.style == Diagonal &&
+               int(random(100)) < config.bias_percent) {
+      if (f.d1 != f.d2 && has_d2)
+        d = f.d2; /*< 交互にターンして階段状に */
+      else if (f.d1 == f.d2 && d == f.d1 && count > 1)
+        d = candidates[(k + 1 + random(count - 1)) % count]; /*< 曲がる */
+    }
+    const auto n = f.p.next(d);
+    removeWall(f.p, d);
+    if (goal[n.getIndex()]) {
+      goal_connected = true;
+      continue;
+    }
+    visited[n.getIndex()] = true;
+    stack.push_back({n, d, f.d1});
+  }
+}
+void MazeGenerator::braid(const Config &config,
+                          const std::bitset<Position::SIZE> &goal) {
+  for (coord_t x = 0; x < maze_size; ++x)
+    for (coord_t y = 0; y < maze_size; ++y) {
+      const auto p = Position(x, y);
+      /* スタート区画とゴール区画は変えない */
+      if (p == Position(0, 0) || goal[p.getIndex()] || wallCount(p) != 3 ||
+          int(random(100)) >= config.braid_percent)
+        continue;
+      /* 壊せる壁の候補．行き止まり同士をつなぐ壁を優先する */
+      Direction candidates[4], preferred[4];
+      int count = 0, preferred_count = 0;
+      for (const auto d : Direction::Along4) {
+        const auto n = p.next(d);
+        if (!isWall(p, d) || n.x < 0 || n.y < 0 || n.x >= maze_size ||
+            n.y >= maze_size || n == Position(0, 0) || goal[n.getIndex()])
+          continue;
+        /* 壁の両端の柱に他の壁が残ること */
+        const auto i = WallIndex(p, d);
+        const coord_t px = i.x + 1, py = i.y + 1;
+        const bool ok = i.z == 0 ? (pillarWallCount(px, i.y) > 1 &&
+                                    pillarWallCount(px, py) > 1)
+                                 : (pillarWallCount(i.x, py) > 1 &&
+                                    pillarWallCount(px, py) > 1);
+        if (!ok)
+          continue;
+        candidates[count++] = d;
+        if (wallCount(n) == 3)
+          preferred[preferred_count++] = d;
+      }
+      if (preferred_count)
+        removeWall(p, preferred[random(preferred_count)]);
+      else if (count)
+        removeWall(p, candidates[random(count)]);
+    }
+}
+
+} // namespace MazeLib
@@ -0,0 +1,36 @@
+/**
+ * @file MazePublisher.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief スレッド間で迷路のスナップショットを受け渡すクラス
+ * @date 2026.10.19
+ */
+#include "MazePublisher.h"
+
+namespace MazeLib {
+
+MazePublisher::MazePublisher(const Maze &maze) : middle(2) {
+  /* 全バッファを初期状態にしておき，以降のメモリ確保を避ける */
+  for (auto &slot : slots)
+    assign(slot, maze);
+}
+uint32_t MazePublisher::publish(const Maze &maze) {
+  auto &slot = slots[back];
+  assign(slot, maze);
+  slot.generation = ++generation;
+  /* 書き込んだバッファを公開し，前回の公開バッファを次の書き込み先にする */
+  back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+  return generation;
+}
+void MazePublisher::assign(Snapshot &slot, const Maze &maze) {
+  slot.maze = maze;
+  slot.start = maze.getStart();
+  slot.goals = maze.getGoals(); /*< 要素数が増えなければ再確保しない */
+}
+const MazePublisher::Snapshot &MazePublisher::acquire() {
+  /* 新しい世代があれば，所有するバッファと交換する */
+  if (middle.load(std::memory_order_relaxed) & FRESH)
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+  return slots[front];
+}
+
+} // namespace MazeLib
@@ -0,0 +1,161 @@
+/**
+ * @file MazeRenderer.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 迷路やステップマップを文字列に描画するクラス
+ * @date 2026.10.19
+ */
+#include "MazeRenderer.h"
+#include "StepMap.h"
+
+#include <algorithm> /*< for std::max */
+#include <cstdio>    /*< for std::snprintf */
+
+namespace MazeLib {
+
+/* MAZE_COLOR_DISABLED に依存しない ANSI エスケープシーケンス */
+static constexpr const char *ESC_RE = "\x1b[31m";
+static constexpr const char *ESC_YE = "\x1b[33m";
+static constexpr const char *ESC_BL = "\x1b[34m";
+static constexpr const char *ESC_CY = "\x1b[36m";
+static constexpr const char *ESC_PATH = "\x1b[43m\x1b[34m";
+static constexpr const char *ESC_NO = "\x1b[0m";
+
+#ifdef MAZE_COLOR_DISABLED
+bool MazeRenderer::color_default = false;
+#else
+bool MazeRenderer::color_default = true;
+#endif
+
+void MazeRenderer::print(const Maze &maze, const Directions &dirs,
+                         const Position &start, std::ostream &os,
+                         const int maze_size) {
+  clearOverlay();
+  rasterize(dirs, start);
+  render(maze, nullptr, start, maze_size);
+  os.write(buffer.data(), buffer.size()).flush();
+}
+void MazeRenderer::print(const Maze &maze, const Positions &positions,
+                         std::ostream &os, const int maze_size) {
+  clearOverlay();
+  for (const auto p : positions)
+    if (p.isInsideOfField())
+      highlights[p.getIndex()] = true;
+  render(maze, nullptr, maze.getStart(), maze_size);
+  os.write(buffer.data(), buffer.size()).flush();
+}
+void MazeRenderer::print(const Maze &maze, const StepMap &step_map,
+                         const Directions &dirs, const Position &start,
+                         std::ostream &os, const int maze_size) {
+  clearOverlay();
+  rasterize(dirs, start);
+  render(maze, &step_map, start, maze_size);
+  os.write(buffer.data(), buffer.size()).flush();
+}
+void MazeRenderer::clearOverlay() {
+  vertical.fill(int8_t(Direction::Max));
+  horizontal.fill(int8_t(Direction::Max));
+  highlights.reset();
+}
+void MazeRenderer::rasterize(const Directions &dirs, const Position &start) {
+  auto p = start;
+  for (const auto d : dirs) {
+    if (d.isAlong()) {
+      /* 壁の通し番号を東壁，北壁から西壁，南壁に読み替える */
+      const auto i = WallIndex(p, d);
+      const int x = i.x + (i.z == 0), y = i.y + (i.z == 1);
+      auto &overlay = i.z == 0 ? vertical : horizontal;
+      if (0 <= x && x < OVERLAY_SIZE && 0 <= y && y < OVERLAY_SIZE &&
+          overlay[y * OVERLAY_SIZE + x] == Direction::Max)
+        overlay[y * OVERLAY_SIZE + x] = d;
+    }
+    p = p.next(d);
+  }
+}
+void MazeRenderer::render(const Maze &maze, const StepMap *step_map,
+                          const Position &start, const int maze_size) {
+  goals.reset();
+  for (const auto p : maze.getGoals())
+    if (p.isInsideOfField())
+      goals[p.getIndex()] = true;
+  const char *esc_path = step_map ? ESC_PATH : ESC_YE;
+  /* ステップマップの表示形式 */
+  bool simple = true;
+  if (step_map) {
+    StepMap::step_t max_step = 0;
+    for (const auto step : step_map->getMapArray())
+      if (step != StepMap::STEP_MAX)
+        max_step = std::max(max_step, step);
+    simple = (max_step < 999);
+  }
+  /* 1行あたり最大で区画ごとに壁と区画の2要素を色付きで描く */
+  buffer.clear();
+  buffer.reserve((2 * maze_size + 1) * (maze_size + 1) * 2 * 16);
+  char str[8];
+  for (coord_t y = maze_size; y >= 0; --y) {
+    if (y != maze_size) {
+      for (coord_t x = 0; x <= maze_size; ++x) {
+        /* Vertical Wall */
+        const auto d = vertical[y * OVERLAY_SIZE + x];
+        if (d != Direction::Max) {
+          str[0] = Direction(d).toChar(), str[1] = '\0';
+          put(esc_path, str);
+        } else if (!maze.isKnown(x, y, Direction::West)) {
+          put(ESC_RE, ".");
+        } else {
+          put(nullptr, maze.isWall(x, y, Direction::West) ? "|" : " ");
+        }
+        /* Breaking Condition */
+        if (x == maze_size)
+          break;
+        /* Cell */
+        const auto p = Position(x, y);
+        if (step_map) {
+          const auto step = step_map->getStep(p);
+          if (step == StepMap::STEP_MAX)
+            put(ESC_CY, "999");
+          else {
+            std::snprintf(str, sizeof(str), "%3d",
+                          simple ? step : step / 100);
+            put(step == 0 ? ESC_YE : ESC_CY, str);
+          }
+        } else if (p == start) {
+          put(ESC_BL, " S ");
+        } else if (goals[p.getIndex()]) {
+          put(ESC_BL, " G ");
+        } else if (highlights[p.getIndex()]) {
+          put(ESC_YE, " X ");
+        } else {
+          put(nullptr, "   ");
+        }
+      }
+      put(nullptr, "\n");
+    }
+    for (coord_t x = 0; x < maze_size; ++x) {
+      /* Pillar */
+      put(nullptr, "+");
+      /* Horizontal Wall */
+      const auto d = horizontal[y * OVERLAY_SIZE + x];
+      if (d != Direction::Max) {
+        str[0] = ' ', str[1] = Direction(d).toChar(), str[2] = ' ';
+        str[3] = '\0';
+        put(esc_path, str);
+      } else if (!maze.isKnown(x, y, Direction::South)) {
+        put(ESC_RE, " . ");
+      } else {
+        put(nullptr, maze.isWall(x, y, Direction::South) ? "---" : "   ");
+      }
+    }
+    /* Last Pillar */
+    put(nullptr, "+");
+    put(nullptr, "\n");
+  }
+}
+void MazeRenderer::put(const char *esc, const char *str) {
+  if (esc && color)
+    buffer += esc;
+  buffer += str;
+  if (esc && color)
+    buffer += ESC_NO;
+}
+
+} // namespace MazeLib
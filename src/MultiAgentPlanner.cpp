@@ -0,0 +1,99 @@
+/**
+ * @file MultiAgentPlanner.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 複数のエージェントで1つの迷路を協調して探索する計画を立てるクラス
+ * @date 2026.10.19
+ */
+#include "MultiAgentPlanner.h"
+
+#include <algorithm> /*< for std::find */
+
+namespace MazeLib {
+
+WallIndexes MultiAgentPlanner::merge(const Maze &observed,
+                                     const Maze::MergePolicy policy) {
+  const auto conflicts = maze.mergeWalls(observed, policy);
+  /* 壁ログに残らない変更なので差分更新の状態を破棄 */
+  search_algorithm.invalidate();
+  return conflicts;
+}
+bool MultiAgentPlanner::assign(const Positions &positions, const bool simple,
+                               const bool full) {
+  const int agent_count = getAgentCount();
+  assignments.assign(agent_count, Assignment());
+  if (!full && search_algorithm.isShortestDetermined(0, simple))
+    return false;
+  /* 各エージェントの現在地から各区画への距離 (未知壁は壁なし) */
+  for (int a = 0; a < agent_count; ++a)
+    step_maps[a].update(maze, {positions[a]}, false, simple);
+  /* 現在地の未知壁は到着時に観測されるので予約済みとする */
+  claimed.reset();
+  for (const auto p : positions)
+    claim(p);
+  /* 最短経路を確定するための区画を優先して割り当てる */
+  std::vector<bool> busy(agent_count, false);
+  if (!full)
+    assignGreedy(search_algorithm.findShortestCandidates(simple), busy);
+  /* 残ったエージェントには，未知壁を持つその他の区画を割り当てる */
+  if (std::find(busy.cbegin(), busy.cend(), false) != busy.cend()) {
+    const auto &dead_end = search_algorithm.getDeadEndMap();
+    Positions frontier;
+    for (coord_t x = 0; x < MAZE_SIZE; ++x)
+      for (coord_t y = 0; y < MAZE_SIZE; ++y)
+        if (maze.unknownCount(Position(x, y)) &&
+            !dead_end.isDeadEnd(Position(x, y)))
+          frontier.push_back(Position(x, y));
+    assignGreedy(frontier, busy);
+  }
+  /* 割り当てた区画への経路を導出 */
+  bool assigned = false;
+  for (int a = 0; a < agent_count; ++a) {
+    if (!busy[a])
+      continue;
+    auto &assignment = assignments[a];
+    assignment.dirs = step_maps[a].calcShortestDirections(
+        maze, positions[a], {assignment.target}, false, simple);
+    assigned |= !assignment.dirs.empty();
+  }
+  return assigned;
+}
+bool MultiAgentPlanner::isClaimable(const Position p) const {
+  for (const auto d : Direction::Along4) {
+    const auto i = WallIndex(p, d);
+    if (i.isInsideOfField() && !maze.isKnown(i) && !claimed[i.getIndex()])
+      return true;
+  }
+  return false;
+}
+void MultiAgentPlanner::claim(const Position p) {
+  for (const auto d : Direction::Along4) {
+    const auto i = WallIndex(p, d);
+    if (i.isInsideOfField() && !maze.isKnown(i))
+      claimed[i.getIndex()] = true;
+  }
+}
+void MultiAgentPlanner::assignGreedy(const Positions &candidates,
+                                     std::vector<bool> &busy) {
+  while (1) {
+    /* 待機中のエージェントと予約可能な区画の組で，距離が最短のもの */
+    int best_agent = -1;
+    Position best_target;
+    StepMap::step_t best_step = StepMap::STEP_MAX;
+    for (int a = 0; a < getAgentCount(); ++a) {
+      if (busy[a])
+        continue;
+      for (const auto c : candidates) {
+        const auto step = step_maps[a].getStep(c);
+        if (step < best_step && isClaimable(c))
+          best_agent = a, best_target = c, best_step = step;
+      }
+    }
+    if (best_agent < 0)
+      return;
+    claim(best_target);
+    busy[best_agent] = true;
+    assignments[best_agent].target = best_target;
+  }
+}
+
+} // namespace MazeLib
@@ -0,0 +1,173 @@
+/**
+ * @file SearchAlgorithm.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief マイクロマウスの迷路の探索アルゴリズムを扱うクラス
+ * @date 2026.10.19
+ */
+#include "SearchAlgorithm.h"
+
+#include <algorithm> /*< for std::stable_sort */
+#include <utility>   /*< for std::pair */
+
+namespace MazeLib {
+
+SearchAlgorithm::WallGains
+SearchAlgorithm::calcWallGains(const bool simple) {
+  applyWallRecords();
+  /* 未知壁を壁なしとした最短経路 */
+  const auto shortest_dirs = step_map.calcShortestDirections(
+      maze, maze.getStart(), maze.getGoals(), false, simple, dead_end);
+  if (shortest_dirs.empty())
+    return {};
+  const auto base_step = step_map.getStep(maze.getStart());
+  /* 最短経路上の未知壁を壁ありとして最短経路を再計算 */
+  WallGains gains;
+  MazeView maze_what_if = maze; /*< 壁情報のみの複製．動的確保を伴わない */
+  auto p = maze.getStart();
+  for (const auto d : shortest_dirs) {
+    const auto i = WallIndex(p, d);
+    p = p.next(d);
+    if (maze.isKnown(i))
+      continue;
+    maze_what_if.setWall(i, true), maze_what_if.setKnown(i, true);
+    step_map.update(maze_what_if, maze.getGoals(), false, simple, dead_end,
+                    maze.getStart());
+    maze_what_if.setWall(i, false), maze_what_if.setKnown(i, false);
+    /* 台形加速の更新は展開順に依存し，壁を増やしても下がり得るので 0 とする */
+    const auto what_if = step_map.getStep(maze.getStart());
+    gains.push_back({i, StepMap::step_t(
+                            what_if > base_step ? what_if - base_step : 0)});
+  }
+  /* コスト増分の降順に並べ替え (同じ増分なら経路順) */
+  std::stable_sort(gains.begin(), gains.end(),
+                   [](const WallGain &g1, const WallGain &g2) {
+                     return g1.gain > g2.gain;
+                   });
+  return gains;
+}
+Positions SearchAlgorithm::findShortestCandidates(const bool simple) {
+  const auto gains = calcWallGains(simple);
+  /* コスト増分が正の壁がなければ，経路上の全未知壁を対象とする */
+  const bool all = gains.empty() || gains.front().gain == 0;
+  Positions candidates;
+  const auto push = [&](const Position p) {
+    if (!dead_end.isDeadEnd(p) &&
+        std::find(candidates.cbegin(), candidates.cend(), p) ==
+            candidates.cend())
+      candidates.push_back(p);
+  };
+  for (const auto &g : gains) {
+    if (!all && g.gain == 0)
+      break;
+    push(g.i.getPosition());
+    push(g.i.getPosition().next(g.i.getDirection()));
+  }
+  return candidates;
+}
+bool SearchAlgorithm::isShortestDetermined(const StepMap::step_t epsilon,
+                                           const bool simple) {
+  if (cost_simple != simple)
+    invalidate(), cost_simple = simple;
+  applyWallRecords();
+  /* 未知壁を壁なしとした最短経路 (コストの下限) */
+  if (!optimistic_valid) {
+    const auto dirs = step_map.calcShortestDirections(
+        maze, maze.getStart(), maze.getGoals(), false, simple, dead_end);
+    optimistic_cost =
+        dirs.empty() ? StepMap::STEP_MAX : step_map.getStep(maze.getStart());
+    optimistic_walls.reset();
+    auto p = maze.getStart();
+    for (const auto d : dirs)
+      optimistic_walls[WallIndex(p, d).getIndex()] = true, p = p.next(d);
+    optimistic_valid = true;
+  }
+  /* 既知壁のみの最短経路 */
+  if (!known_valid) {
+    const auto dirs = step_map.calcShortestDirections(
+        maze, maze.getStart(), maze.getGoals(), true, simple, dead_end);
+    known_cost =
+        dirs.empty() ? StepMap::STEP_MAX : step_map.getStep(maze.getStart());
+    known_valid = true;
+  }
+  if (known_cost == StepMap::STEP_MAX)
+    return false;
+  return known_cost <= uint32_t(optimistic_cost) + epsilon;
+}
+Directions SearchAlgorithm::calcReturnDirections(const Position &start,
+                                                 const StepMap::step_t max_cost,
+                                                 const int k,
+                                                 const bool simple) {
+  /* 最短経路のコストを変え得る未知壁 */
+  std::bitset<WallIndex::SIZE> gain_walls;
+  for (const auto &g : calcWallGains(simple))
+    if (g.gain > 0)
+      gain_walls[g.i.getIndex()] = true;
+  /* 基準とする既知壁のみの最短経路 */
+  const auto known_dirs = step_map.calcShortestDirections(
+      maze, start, {maze.getStart()}, true, simple);
+  if (known_dirs.empty() || step_map.getStep(start) > max_cost)
+    return known_dirs;
+  /* 経路上で観測できる有用な未知壁の数．(コスト増分が正の壁，有用な壁) */
+  const auto score = [&](const Directions &dirs) {
+    std::bitset<WallIndex::SIZE> seen;
+    std::pair<int, int> result{0, 0};
+    auto p = start;
+    for (const auto d : dirs) {
+      p = p.next(d);
+      for (const auto rd :
+           {Direction::Front, Direction::Left, Direction::Right}) {
+        const auto i = WallIndex(p, d + rd);
+        if (!i.isInsideOfField() || maze.isKnown(i) || seen[i.getIndex()])
+          continue;
+        seen[i.getIndex()] = true;
+        if (dead_end.isDeadEnd(i.getPosition()) ||
+            dead_end.isDeadEnd(i.getPosition().next(i.getDirection())))
+          continue;
+        result.first += gain_walls[i.getIndex()];
+        result.second += 1;
+      }
+    }
+    return result;
+  };
+  /* 未知壁を壁なしとした経路の候補から，上限以内で評価の高い経路を選ぶ */
+  const auto routes = step_map.calcKShortestRoutes(
+      maze, start, {maze.getStart()}, k, false, simple);
+  const Directions *best = &known_dirs;
+  auto best_score = score(known_dirs);
+  for (const auto &route : routes) {
+    if (route.cost > max_cost)
+      break; /*< コストの昇順 */
+    const auto s = score(route.dirs);
+    if (s > best_score)
+      best = &route.dirs, best_score = s;
+  }
+  return *best;
+}
+void SearchAlgorithm::applyWallRecords() {
+  const auto &records = maze.getWallRecords();
+  /* 壁ログが書き換えられた場合やゴールが変更された場合は全て再計算 */
+  auto protected_cells = maze.getGoals();
+  protected_cells.push_back(maze.getStart());
+  if (wall_records_count < records.getBegin() ||
+      wall_records_count > records.getEnd() ||
+      protected_cells != dead_end.getProtectedCells()) {
+    invalidate();
+    wall_records_count = records.getEnd();
+  }
+  for (size_t n = wall_records_count; n < records.getEnd(); ++n) {
+    const auto &record = records[n - records.getBegin()];
+    const auto i = WallIndex(record.getPosition(), record.getDirection());
+    if (!i.isInsideOfField())
+      continue;
+    dead_end.updateWall(maze, i);
+    if (!maze.isKnown(i))
+      invalidate(); /*< 既知壁と食い違って未知壁に戻された */
+    else if (maze.isWall(i))
+      optimistic_valid &= !optimistic_walls[i.getIndex()];
+    else
+      known_valid = false;
+  }
+  wall_records_count = records.getEnd();
+}
+
+} // namespace MazeLib
@@ -0,0 +1,143 @@
+/**
+ * @file SpeculativePlanner.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 次の区画の壁の観測結果ごとに経路を先行して導出するクラス
+ * @date 2026.10.19
+ */
+#include "SpeculativePlanner.h"
+
+#include <algorithm> /*< for std::min, std::max, std::none_of */
+
+namespace MazeLib {
+
+/* 前・左・右の相対方向．組合せの bit 0, 1, 2 に対応 */
+static constexpr Direction::RelativeDirection relative_dirs[3] = {
+    Direction::Front, Direction::Left, Direction::Right};
+
+SpeculativePlanner::SpeculativePlanner(const bool parallel)
+    : parallel(parallel) {
+  if (!parallel)
+    return;
+  /* 作業スレッドは組合せの数まで．以降は区画ごとに使い回す */
+  const int n = std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                      unsigned(OUTCOME_SIZE)));
+  for (int i = 0; i < n; ++i)
+    workers.emplace_back(&SpeculativePlanner::work, this);
+}
+SpeculativePlanner::~SpeculativePlanner() {
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  requested.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+void SpeculativePlanner::prepare(const Maze &maze, const Pose &next,
+                                 const Positions &dest, const bool known_only,
+                                 const bool simple) {
+  wait();
+  this->pose = next;
+  this->dest = dest;
+  this->known_only = known_only;
+  this->simple = simple;
+  /* 既知の壁は既知の値に固定する */
+  fixed = fixed_walls = 0;
+  for (int i = 0; i < 3; ++i) {
+    const auto d = next.d + relative_dirs[i];
+    if (!maze.isKnown(next.p, d))
+      continue;
+    fixed |= 1 << i;
+    fixed_walls |= maze.isWall(next.p, d) << i;
+  }
+  /* 未知の壁の組合せごとに迷路を複製する．作業スレッドは開始待ちの
+   * 組合せのみを参照するので，ここでは排他制御は不要 */
+  uint8_t expanded = 0;
+  outcome_count = 0;
+  for (int k = 0; k < OUTCOME_SIZE; ++k) {
+    if ((k & fixed) != fixed_walls)
+      continue;
+    auto &outcome = outcomes[k];
+    outcome.maze = maze; /*< 壁情報のみの複製．動的確保を伴わない */
+    for (int i = 0; i < 3; ++i) {
+      if (fixed >> i & 1)
+        continue;
+      const auto d = next.d + relative_dirs[i];
+      outcome.maze.setWall(next.p, d, k >> i & 1);
+      outcome.maze.setKnown(next.p, d, true);
+    }
+    expanded |= 1 << k;
+    ++outcome_count;
+  }
+  /* 導出を依頼する */
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int k = 0; k < OUTCOME_SIZE; ++k)
+      outcomes[k].state = (expanded >> k & 1) ? Pending : Idle;
+  }
+  requested.notify_all();
+}
+const SpeculativePlanner::NextDirections &
+SpeculativePlanner::lookup(const bool wall_front, const bool wall_left,
+                           const bool wall_right) {
+  static const NextDirections empty;
+  if (!isPrepared())
+    return empty;
+  /* 既知の壁は既知の値を使う */
+  const int observed = wall_front | wall_left << 1 | wall_right << 2;
+  looked_up = (observed & ~fixed) | fixed_walls;
+  auto &outcome = outcomes[looked_up];
+  std::unique_lock<std::mutex> lock(mutex);
+  /* 未着手であれば，作業スレッドを待たずにここで導出する */
+  if (outcome.state == Idle || outcome.state == Pending) {
+    outcome.state = Running;
+    lock.unlock();
+    run(outcome);
+    lock.lock();
+    outcome.state = Done;
+    finished.notify_all();
+  }
+  finished.wait(lock, [&] { return outcome.state == Done; });
+  return outcome.next;
+}
+void SpeculativePlanner::wait() {
+  /* 待つのは導出中のもののみ．開始待ちのものは実行せずに破棄する */
+  std::unique_lock<std::mutex> lock(mutex);
+  for (auto &outcome : outcomes)
+    if (outcome.state == Pending)
+      outcome.state = Idle;
+  finished.wait(lock, [&] {
+    return std::none_of(
+        std::begin(outcomes), std::end(outcomes),
+        [](const Outcome &outcome) { return outcome.state == Running; });
+  });
+}
+void SpeculativePlanner::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (1) {
+    /* 開始待ちの組合せを探す */
+    Outcome *outcome = nullptr;
+    requested.wait(lock, [&] {
+      for (auto &o : outcomes)
+        if (o.state == Pending)
+          return outcome = &o, true;
+      return stopping;
+    });
+    if (!outcome)
+      return;
+    outcome->state = Running;
+    lock.unlock();
+    run(*outcome);
+    lock.lock();
+    outcome->state = Done;
+    finished.notify_all();
+  }
+}
+void SpeculativePlanner::run(Outcome &outcome) {
+  outcome.step_map.update(outcome.maze, dest, known_only, simple);
+  outcome.next.end = outcome.step_map.calcNextDirections(
+      outcome.maze, pose, outcome.next.known, outcome.next.candidates);
+}
+
+} // namespace MazeLib
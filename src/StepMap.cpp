@@ -5,16 +5,22 @@
  * @date 2017.11.05
  */
 #include "StepMap.h"
+#include "MazeRenderer.h"
 
-#include <algorithm> /*< for std::sort */
-#include <cmath>     /*< for std::sqrt, std::pow */
-#include <iomanip>   /*< for std::setw() */
+#include <algorithm>  /*< for std::sort */
+#include <cstring>    /*< for std::memcpy */
+#include <functional> /*< for std::greater */
+#include <iomanip>    /*< for std::setw() */
 #include <queue>
+#include <tuple>       /*< for std::tuple */
+#include <type_traits> /*< for std::make_signed */
 
 namespace MazeLib {
 
-StepMap::StepMap() {
-  calcStraightStepTable();
+constexpr int StepQueue::CAPACITY;
+
+StepMap::StepMap(const CostModel::Table &cost_table)
+    : step_table(cost_table.table) {
   reset();
 }
 void StepMap::print(const Maze &maze, const Position &p, const Direction d,
@@ -23,63 +29,7 @@ void StepMap::print(const Maze &maze, const Position &p, const Direction d,
 }
 void StepMap::print(const Maze &maze, const Directions &dirs,
                     const Position &start, std::ostream &os) const {
-  /* preparation */
-  std::vector<Pose> path;
-  Position p = start;
-  for (const auto d : dirs)
-    path.push_back({p, d}), p = p.next(d);
-  const int maze_size = MAZE_SIZE;
-  step_t max_step = 0;
-  for (const auto step : step_map)
-    if (step != STEP_MAX)
-      max_step = std::max(max_step, step);
-  const bool simple = (max_step < 999);
-  const auto find = [&](const WallIndex &i) {
-    return std::find_if(path.cbegin(), path.cend(), [&](const Pose &pose) {
-      return WallIndex(pose.p, pose.d) == i;
-    });
-  };
-  /* start to draw maze */
-  for (int8_t y = maze_size; y >= 0; --y) {
-    if (y != maze_size) {
-      for (uint8_t x = 0; x <= maze_size; ++x) {
-        /* Vertical Wall */
-        const auto w = maze.isWall(x, y, Direction::West);
-        const auto k = maze.isKnown(x, y, Direction::West);
-        const auto it = find(WallIndex(Position(x, y), Direction::West));
-        if (it != path.cend())
-          os << "\e[43m\e[34m" << it->d << C_NO;
-        else
-          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
-        /* Cell */
-        if (x != maze_size) {
-          if (getStep(x, y) == STEP_MAX)
-            os << C_CY << "999" << C_NO;
-          else if (getStep(x, y) == 0)
-            os << C_YE << std::setw(3) << getStep(x, y) << C_NO;
-          else if (simple)
-            os << C_CY << std::setw(3) << getStep(x, y) << C_NO;
-          else
-            os << C_CY << std::setw(3) << getStep(x, y) / 100 << C_NO;
-        }
-      }
-      os << std::endl;
-    }
-    for (uint8_t x = 0; x < maze_size; ++x) {
-      /* Pillar */
-      os << '+';
-      /* Horizontal Wall */
-      const auto w = maze.isWall(x, y, Direction::South);
-      const auto k = maze.isKnown(x, y, Direction::South);
-      const auto it = find(WallIndex(Position(x, y), Direction::South));
-      if (it != path.cend())
-        os << "\e[43m\e[34m " << it->d << ' ' << C_NO;
-      else
-        os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
-    }
-    /* Last Pillar */
-    os << '+' << std::endl;
-  }
+  MazeRenderer().print(maze, *this, dirs, start, os);
 }
 void StepMap::printFull(const Maze &maze, const Position &p, const Direction d,
                         std::ostream &os) const {
@@ -93,10 +43,10 @@ void StepMap::printFull(const Maze &maze, const Directions &dirs,
     p = p.next(d);
     path.push_back({p, d});
   }
-  for (int8_t y = MAZE_SIZE; y >= 0; --y) {
+  for (coord_t y = MAZE_SIZE; y >= 0; --y) {
     if (y != MAZE_SIZE) {
       os << '|';
-      for (uint8_t x = 0; x < MAZE_SIZE; ++x) {
+      for (coord_t x = 0; x < MAZE_SIZE; ++x) {
         os << C_CY << std::setw(5) << std::min((int)getStep(x, y), 99999)
            << C_NO;
         bool found = false;
@@ -118,7 +68,7 @@ void StepMap::printFull(const Maze &maze, const Directions &dirs,
       }
       os << std::endl;
     }
-    for (uint8_t x = 0; x < MAZE_SIZE; ++x) {
+    for (coord_t x = 0; x < MAZE_SIZE; ++x) {
       os << '+';
       bool found = false;
       for (const auto pose : path) {
@@ -140,13 +90,17 @@ void StepMap::printFull(const Maze &maze, const Directions &dirs,
     os << '+' << std::endl;
   }
 }
-void StepMap::update(const Maze &maze, const Positions &dest,
-                     const bool known_only, const bool simple) {
+void StepMap::updateImpl(const MazeView &maze, const Positions &dest,
+                         const bool known_only, const bool simple,
+                         const std::bitset<Position::SIZE> *enterable,
+                         const Backend backend) {
+  if (backend == Sweep)
+    return updateSweep(maze, dest, known_only, simple, enterable);
   /* 計算を高速化するため，迷路の大きさを制限 */
-  int8_t min_x = maze.getMinX();
-  int8_t max_x = maze.getMaxX();
-  int8_t min_y = maze.getMinY();
-  int8_t max_y = maze.getMaxY();
+  coord_t min_x = maze.getMinX();
+  coord_t max_x = maze.getMaxX();
+  coord_t min_y = maze.getMinY();
+  coord_t max_y = maze.getMaxY();
   for (const auto p : dest) { /*< ゴールを含めないと導出不可能になる */
     min_x = std::min(p.x, min_x);
     max_x = std::max(p.x, max_x);
@@ -154,44 +108,255 @@ void StepMap::update(const Maze &maze, const Positions &dest,
     max_y = std::max(p.y, max_y);
   }
   min_x -= 1, min_y -= 1, max_x += 2, max_y += 2; /*< 外周を許す */
-  /* 直線優先 */
-  const int max_straight = simple ? 1 : MAZE_SIZE * 2;
   /* 全区画のステップを最大値に設定 */
   reset();
-  /* ステップの更新予約のキュー */
-  std::queue<Position> q;
+  /* ステップの更新予約のキュー．区画の通し番号を持つ */
+  auto &q = getQueue();
   /* destのステップを0とする */
   for (const auto p : dest)
     if (p.isInsideOfField())
-      setStep(p, 0), q.push(p);
+      setStep(p, 0), q.push(p.getIndex());
   /* ステップの更新がなくなるまで更新処理 */
   while (!q.empty()) {
     /* 注目する区画を取得 */
-    const auto &&focus = std::move(q.front());
-    q.pop();
-    const auto focus_step = step_map[focus.getIndex()];
-    /* 周辺を走査 */
-    for (const auto d : Direction::Along4) {
-      /* 直線で行けるところまで更新する */
-      auto next = focus;
-      for (int8_t i = 1; i <= max_straight; ++i) {
-        /* 壁あり or 既知壁のみで未知壁 ならば次へ */
-        const auto next_wi = WallIndex(next, d);
-        if (maze.isWall(next_wi) || (known_only && !maze.isKnown(next_wi)))
-          break;
-        next = next.next(d); /*< 移動 */
-        /* 直線加速を考慮したステップを算出 */
-        const auto next_step = focus_step + (simple ? 1 : step_table[i]);
-        const auto next_index = next.getIndex();
-        if (step_map[next_index] <= next_step)
-          break;                          /*< 更新の必要がない */
-        step_map[next_index] = next_step; /*< 更新 */
-        q.push(next); /*< 再帰的に更新され得るのでキューにプッシュ */
+    const auto focus = q.pop();
+    relaxFrom(maze, focus, known_only, simple, enterable, q);
+  }
+}
+void StepMap::relaxFrom(const MazeView &maze, const index_t focus,
+                        const bool known_only, const bool simple,
+                        const std::bitset<Position::SIZE> *enterable,
+                        StepQueue &q) {
+  /* 直線優先 */
+  const int max_straight = simple ? 1 : MAZE_SIZE * 2;
+  /* 隣接区画と壁の通し番号の表，壁のビット列 */
+  const auto &table = NeighborTable::Table;
+  const auto &wall = maze.getWallBits();
+  const auto &known = maze.getKnownBits();
+  const auto focus_step = step_map[focus];
+  /* 周辺を走査 */
+  for (int d = 0; d < 4; ++d) {
+    /* 直線で行けるところまで更新する */
+    auto next_index = focus;
+    for (int i = 1; i <= max_straight; ++i) {
+      /* 外周 or 壁あり or 既知壁のみで未知壁 ならば次へ */
+      const auto next_wi = table.wall[next_index][d];
+      if (next_wi == NeighborTable::OUTSIDE || wall[next_wi] ||
+          (known_only && !known[next_wi]))
+        break;
+      next_index = table.cell[next_index][d]; /*< 移動 */
+      /* 展開しない区画 (袋小路) ならば次へ */
+      if (enterable && !(*enterable)[next_index])
+        break;
+      /* 直線加速を考慮したステップを算出 */
+      const auto next_step = addStep(focus_step, simple ? 1 : step_table[i]);
+      if (step_map[next_index] <= next_step)
+        break;                          /*< 更新の必要がない */
+      step_map[next_index] = next_step; /*< 更新 */
+      q.push(next_index); /*< 再帰的に更新され得るのでキューにプッシュ */
+    }
+  }
+}
+/**
+ * @brief 迷路の1列 (または転置した1行) の一部の区画のステップ
+ *
+ * SSE2 などの 16 byte のベクトル命令に収まる大きさとし，1列を複数に分割する．
+ * 符号なしの比較は SSE2 などにないため，最上位ビットを反転した値で保持し，
+ * 符号付きの比較で大小を判定する．加算はそのまま行える．
+ */
+typedef std::make_signed<StepMap::step_t>::type line_elem_t;
+typedef line_elem_t line_vec_t __attribute__((vector_size(16)));
+typedef StepMap::step_t line_uvec_t __attribute__((vector_size(16)));
+/** @brief line_vec_t の比較結果 (真の要素は全ビット1) */
+typedef line_vec_t line_mask_t;
+/** @brief line_vec_t の要素数 */
+static constexpr int LINE_LANES = 16 / sizeof(line_elem_t);
+/** @brief 1列の分割数 */
+static constexpr int LINE_CHUNKS = (MAZE_SIZE + LINE_LANES - 1) / LINE_LANES;
+/** @brief 1列のベクトル */
+typedef line_vec_t line_t[LINE_CHUNKS];
+/** @brief 最上位ビット */
+static constexpr StepMap::step_t LINE_BIAS = StepMap::STEP_MAX ^
+                                             (StepMap::STEP_MAX >> 1);
+/** @brief STEP_MAX を最上位ビットを反転した値 */
+static constexpr line_elem_t LINE_MAX = StepMap::STEP_MAX >> 1;
+
+/** @brief 真の要素が1つでもあるかどうか */
+static bool any(const line_mask_t &m) {
+  uint64_t w[sizeof(m) / sizeof(uint64_t)];
+  std::memcpy(w, &m, sizeof(m));
+  uint64_t r = 0;
+  for (const auto v : w)
+    r |= v;
+  return r;
+}
+/**
+ * @brief Backend::Sweep の作業領域
+ * @details 大きな迷路ではスタックに収まらないので，StepMap ごとに確保する
+ */
+struct StepMap::SweepBuffer {
+  line_vec_t cost[MAZE_SIZE]; /**< @brief 直線区間のコスト */
+  line_t cols[MAZE_SIZE];     /**< @brief 列 (x 固定) ごとのステップ */
+  line_t rows[MAZE_SIZE];     /**< @brief 転置した行 (y 固定) ごとのステップ */
+  line_t east[MAZE_SIZE];     /**< @brief 列 x から x + 1 へ進めるか */
+  line_t west[MAZE_SIZE];     /**< @brief 列 x + 1 から x へ進めるか */
+  line_t north[MAZE_SIZE];    /**< @brief 行 y から y + 1 へ進めるか */
+  line_t south[MAZE_SIZE];    /**< @brief 行 y + 1 から y へ進めるか */
+};
+/**
+ * @brief 1方向の軸に沿った一括緩和
+ *
+ * 列の番号の昇順と降順にそれぞれ走査し，直線で到達できる列からの候補の
+ * min を取る．head 区画未満の直線は候補を直接調べ，head 区画以上の直線は
+ * コストが1区画あたり slope で増えるので，前方・後方の累積 min として
+ * 持ち越す．1回の走査の計算量は O(MAZE_SIZE * head) となる．
+ * @param v 各列のステップ (最上位ビット反転)．列の番号の方向に緩和する
+ * @param fwd fwd[j] は列 j から列 j + 1 へ進めるかどうか
+ * @param bwd bwd[j] は列 j + 1 から列 j へ進めるかどうか
+ * @param cost cost[i] は i 区画の直線のコスト (全要素同じ値)
+ * @param head 直線のコストの増分が一定となる最小の区画数
+ * @param slope head 区画以上の直線の1区画あたりのコストの増分
+ * @return 更新があったかどうか
+ */
+static bool relaxLines(line_t *v, const line_t *fwd, const line_t *bwd,
+                       const line_vec_t *cost, const int head,
+                       const line_vec_t &slope) {
+  const line_mask_t all = ~line_mask_t{};
+  const line_vec_t unreachable = line_vec_t{} + LINE_MAX;
+  /* 到達できない区画 (LINE_MAX) からの加算は溢れるので除外する */
+  const auto relax = [](line_vec_t &best, const line_vec_t &from,
+                        const line_vec_t &add, const line_mask_t &m) {
+    const auto cand = (line_vec_t)((line_uvec_t)from + (line_uvec_t)add);
+    const line_mask_t better = (cand < best) & ~(cand < from) & m;
+    best = (cand & better) | (best & ~better);
+  };
+  bool changed = false;
+  for (int k = 0; k < 2; ++k) {
+    const int sign = k ? 1 : -1; /*< 候補の列の向き */
+    const auto *pass = k ? bwd : fwd;
+    for (int c = 0; c < LINE_CHUNKS; ++c) {
+      /* head 区画以上の直線の候補の，head 区画までのコストを除いた min */
+      auto carry = unreachable;
+      for (int j = 0; j < MAZE_SIZE; ++j) {
+        const int n = k ? MAZE_SIZE - 1 - j : j;
+        auto best = v[n][c];
+        /* 1列手前までの候補を1区画延長する */
+        if (j > 0) {
+          const auto ext = carry;
+          carry = unreachable;
+          relax(carry, ext, slope, pass[k ? n : n - 1][c]);
+        }
+        /* head 区画未満の直線の候補と，ちょうど head 区画の直線の候補 */
+        line_mask_t m = all;
+        for (int i = 1; i <= head; ++i) {
+          const int src = n + sign * i;
+          if (src < 0 || src >= MAZE_SIZE)
+            break;
+          m &= pass[k ? src - 1 : src][c];
+          if (!any(m))
+            break;
+          const auto from = v[src][c];
+          if (i < head) {
+            relax(best, from, cost[i], m);
+          } else {
+            const line_mask_t take = (from < carry) & m;
+            carry = (from & take) | (carry & ~take);
+          }
+        }
+        relax(best, carry, cost[head], all);
+        if (any(best < v[n][c])) /*< best は v[n][c] 以下 */
+          v[n][c] = best, changed = true;
+      }
+    }
+  }
+  return changed;
+}
+StepMap::StepMap(const StepMap &obj)
+    : step_map(obj.step_map), step_table(obj.step_table) {}
+StepMap &StepMap::operator=(const StepMap &obj) {
+  step_map = obj.step_map;
+  step_table = obj.step_table;
+  return *this;
+}
+StepMap::~StepMap() {}
+StepQueue &StepMap::getQueue() {
+  if (!queue)
+    queue.reset(new StepQueue);
+  return *queue;
+}
+void StepMap::updateSweep(const MazeView &maze, const Positions &dest,
+                          const bool known_only, const bool simple,
+                          const std::bitset<Position::SIZE> *enterable) {
+  if (!sweep_buffer)
+    sweep_buffer.reset(new SweepBuffer);
+  auto &cost = sweep_buffer->cost;
+  auto &cols = sweep_buffer->cols, &rows = sweep_buffer->rows;
+  auto &east = sweep_buffer->east, &west = sweep_buffer->west;
+  auto &north = sweep_buffer->north, &south = sweep_buffer->south;
+  /* 直線区間のコストと，コストの増分が一定となる区画数 */
+  const auto table = [&](const int i) { return simple ? i : step_table[i]; };
+  for (int i = 0; i < MAZE_SIZE; ++i)
+    cost[i] = line_vec_t{} + line_elem_t(table(i));
+  const int slope = table(MAZE_SIZE - 1) - table(MAZE_SIZE - 2);
+  int head = MAZE_SIZE - 1;
+  while (head > 1 && table(head) - table(head - 1) == slope)
+    --head;
+  const auto slope_vec = line_vec_t{} + line_elem_t(slope);
+  /* 列 (x 固定) ごとのベクトルと，転置した行 (y 固定) ごとのベクトル */
+  for (int i = 0; i < MAZE_SIZE; ++i)
+    for (int c = 0; c < LINE_CHUNKS; ++c)
+      for (int j = 0; j < LINE_LANES; ++j) {
+        cols[i][c][j] = rows[i][c][j] = LINE_MAX;
+        east[i][c][j] = west[i][c][j] = 0;
+        north[i][c][j] = south[i][c][j] = 0;
+      }
+  /* 要素の参照 */
+  const auto at = [](line_t &l, const int i) -> line_elem_t & {
+    return reinterpret_cast<line_elem_t *>(l)[i];
+  };
+  /* 通過できる壁．壁の参照は多いので，ビット列から直接求める */
+  const auto &wall = maze.getWallBits();
+  const auto &known = maze.getKnownBits();
+  const auto is_open = [&](const WallIndex i) {
+    return !wall[i.getIndex()] && (!known_only || known[i.getIndex()]);
+  };
+  const auto is_enterable = [&](const coord_t x, const coord_t y) {
+    return !enterable || (*enterable)[Position(x, y).getIndex()];
+  };
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+      if (x < MAZE_SIZE - 1 && is_open(WallIndex(x, y, 0))) {
+        at(east[x], y) = -is_enterable(x + 1, y);
+        at(west[x], y) = -is_enterable(x, y);
+      }
+      if (y < MAZE_SIZE - 1 && is_open(WallIndex(x, y, 1))) {
+        at(north[y], x) = -is_enterable(x, y + 1);
+        at(south[y], x) = -is_enterable(x, y);
       }
     }
+  /* destのステップを0とする */
+  for (const auto p : dest)
+    if (p.isInsideOfField())
+      at(cols[p.x], p.y) = line_elem_t(0 ^ LINE_BIAS);
+  /* 水平方向と垂直方向の緩和を，更新がなくなるまで交互に繰り返す */
+  bool changed = true;
+  while (changed) {
+    changed = relaxLines(cols, east, west, cost, head, slope_vec);
+    for (int x = 0; x < MAZE_SIZE; ++x)
+      for (int y = 0; y < MAZE_SIZE; ++y)
+        at(rows[y], x) = at(cols[x], y);
+    changed |= relaxLines(rows, north, south, cost, head, slope_vec);
+    for (int x = 0; x < MAZE_SIZE; ++x)
+      for (int y = 0; y < MAZE_SIZE; ++y)
+        at(cols[x], y) = at(rows[y], x);
   }
+  /* 結果を格納 */
+  reset();
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y)
+      step_map[Position(x, y).getIndex()] = step_t(at(cols[x], y)) ^ LINE_BIAS;
 }
-Directions StepMap::calcShortestDirections(const Maze &maze,
+Directions StepMap::calcShortestDirections(const MazeView &maze,
                                            const Position &start,
                                            const Positions &dest,
                                            const bool known_only,
@@ -204,16 +369,202 @@ Directions StepMap::calcShortestDirections(const Maze &maze,
   /* ゴール判定 */
   return step_map[end.p.getIndex()] == 0 ? shortest_dirs : Directions{};
 }
-Pose StepMap::calcNextDirections(const Maze &maze, const Pose &start,
+Directions StepMap::calcShortestDirections(const MazeView &maze,
+                                           const Position &start,
+                                           const Positions &dest,
+                                           const bool known_only,
+                                           const bool simple,
+                                           const DeadEndMap &dead_end) {
+  /* 袋小路を除外してステップマップを更新 */
+  update(maze, dest, known_only, simple, dead_end, start);
+  Pose end;
+  const auto shortest_dirs = getStepDownDirections(
+      maze, {start, Direction::Max}, end, known_only, false);
+  /* ゴール判定 */
+  return step_map[end.p.getIndex()] == 0 ? shortest_dirs : Directions{};
+}
+StepMap::Routes StepMap::calcKShortestRoutes(const MazeView &maze,
+                                             const Position &start,
+                                             const Positions &dest,
+                                             const int k,
+                                             const bool known_only,
+                                             const bool simple) {
+  /* ステップマップを A* のヒューリスティックとして更新 */
+  update(maze, dest, known_only, simple);
+  Routes routes;
+  if (k < 1 || getStep(start) == STEP_MAX)
+    return routes;
+  std::bitset<Position::SIZE> is_dest;
+  for (const auto p : dest)
+    if (p.isInsideOfField())
+      is_dest[p.getIndex()] = true;
+  /* 経路候補の生成 */
+  const auto make_route = [&](const Directions &dirs) {
+    Route route;
+    route.dirs = dirs;
+    route.cost = calcRouteCost(dirs, simple);
+    route.unknown_count = 0;
+    auto p = start;
+    for (const auto d : dirs)
+      route.unknown_count += !maze.isKnown(p, d), p = p.next(d);
+    return route;
+  };
+  const auto contains = [](const Routes &routes, const Directions &dirs) {
+    return std::find_if(routes.cbegin(), routes.cend(), [&](const Route &r) {
+             return r.dirs == dirs;
+           }) != routes.cend();
+  };
+  /* 1本目の最短経路 */
+  Directions spur_dirs;
+  if (is_dest[start.getIndex()])
+    return Routes{make_route({})};
+  if (!calcSpurDirections(maze, {start, Direction::East}, 0, {}, {}, is_dest,
+                          known_only, simple, spur_dirs))
+    return routes;
+  routes.push_back(make_route(spur_dirs));
+  /* Yen のアルゴリズム */
+  Routes candidates;
+  while ((int)routes.size() < k) {
+    const auto last = routes.back().dirs;
+    std::bitset<Position::SIZE> blocked;
+    Position spur = start;
+    int spur_run = 0;
+    for (size_t i = 0; i < last.size(); ++i) {
+      /* 共通の根本経路をもつ既出経路の次の方向を禁止 */
+      std::bitset<Direction::Max> forbidden;
+      for (const auto &r : routes)
+        if (r.dirs.size() > i &&
+            std::equal(last.cbegin(), last.cbegin() + i, r.dirs.cbegin()))
+          forbidden[r.dirs[i]] = true;
+      /* 根本経路上の区画は通過禁止 */
+      blocked[spur.getIndex()] = true;
+      const auto spur_dir = i ? last[i - 1] : Direction(Direction::East);
+      if (calcSpurDirections(maze, {spur, spur_dir}, spur_run, blocked,
+                             forbidden, is_dest, known_only, simple,
+                             spur_dirs)) {
+        Directions dirs(last.cbegin(), last.cbegin() + i);
+        dirs.insert(dirs.end(), spur_dirs.cbegin(), spur_dirs.cend());
+        if (!contains(routes, dirs) && !contains(candidates, dirs))
+          candidates.push_back(make_route(dirs));
+      }
+      /* 根本経路を1区画延長 */
+      spur_run = (i && last[i] == last[i - 1]) ? spur_run + 1 : 1;
+      spur = spur.next(last[i]);
+    }
+    if (candidates.empty())
+      break;
+    /* コストが最小 (同コストなら未知壁が最少) の候補を採用 */
+    const auto it = std::min_element(
+        candidates.cbegin(), candidates.cend(),
+        [](const Route &r1, const Route &r2) {
+          return r1.cost != r2.cost ? r1.cost < r2.cost
+                                    : r1.unknown_count < r2.unknown_count;
+        });
+    routes.push_back(*it);
+    candidates.erase(it);
+  }
+  return routes;
+}
+StepMap::step_t StepMap::calcRouteCost(const Directions &dirs,
+                                       const bool simple) const {
+  uint32_t cost = 0;
+  for (size_t i = 0; i < dirs.size();) {
+    /* 直線区間の長さを数える */
+    int n = 1;
+    while (i + n < dirs.size() && dirs[i + n] == dirs[i])
+      ++n;
+    cost += simple ? n : step_table[std::min(n, MAZE_SIZE - 1)];
+    i += n;
+  }
+  return std::min(cost, (uint32_t)STEP_MAX);
+}
+bool StepMap::calcSpurDirections(const MazeView &maze, const Pose &spur,
+                                 const int spur_run,
+                                 const std::bitset<Position::SIZE> &blocked,
+                                 const std::bitset<Direction::Max> &forbidden,
+                                 const std::bitset<Position::SIZE> &is_dest,
+                                 const bool known_only, const bool simple,
+                                 Directions &spur_dirs) const {
+  /* 状態は (区画, 進入方向) の組．進入方向 Direction::Max は始点のみ */
+  static constexpr int STATE_DIRS = Direction::Max + 1;
+  const auto state = [](const Position p, const int d) {
+    return p.getIndex() * STATE_DIRS + d;
+  };
+  const auto run_cost = [&](const int n) -> uint32_t {
+    return simple ? n : step_table[std::min(n, MAZE_SIZE - 1)];
+  };
+  struct Parent {
+    int state;   /**< @brief 直前の状態 */
+    Direction d; /**< @brief 直線区間の方向 */
+    coord_t n;   /**< @brief 直線区間の長さ */
+  };
+  std::vector<uint32_t> g(Position::SIZE * STATE_DIRS, UINT32_MAX);
+  std::vector<Parent> parent(Position::SIZE * STATE_DIRS);
+  /* (f, g, state) の優先度付きキュー */
+  using Node = std::tuple<uint32_t, uint32_t, int>;
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+  const int start_state = state(spur.p, Direction::Max);
+  g[start_state] = 0;
+  open.push(Node{step_map[spur.p.getIndex()], 0, start_state});
+  while (!open.empty()) {
+    const auto top = open.top();
+    open.pop();
+    const auto cost = std::get<1>(top);
+    const auto s = std::get<2>(top);
+    if (cost != g[s])
+      continue; /*< 更新済みの古い要素 */
+    const auto in_dir = s % STATE_DIRS;
+    const auto focus = Position((s / STATE_DIRS) >> MAZE_SIZE_BIT,
+                                (s / STATE_DIRS) & (MAZE_SIZE_MAX - 1));
+    /* 目的地に到達したら経路を復元 */
+    if (s != start_state && is_dest[focus.getIndex()]) {
+      spur_dirs.clear();
+      for (int t = s; t != start_state; t = parent[t].state)
+        spur_dirs.insert(spur_dirs.end(), parent[t].n, parent[t].d);
+      std::reverse(spur_dirs.begin(), spur_dirs.end());
+      return true;
+    }
+    for (const auto d : Direction::Along4) {
+      if (s == start_state ? forbidden[d] : d == in_dir)
+        continue; /*< 同方向の連続は1つの直線区間とする */
+      /* 始点で根本経路の直線を延長する場合は差分のコスト */
+      const int run = (s == start_state && spur_run && d == spur.d) ? spur_run
+                                                                    : 0;
+      auto next = focus;
+      for (int i = 1; i < MAZE_SIZE; ++i) {
+        /* 壁あり or 既知壁のみで未知壁 ならば次へ */
+        if (maze.isWall(next, d) || (known_only && !maze.isKnown(next, d)))
+          break;
+        next = next.next(d);
+        const auto next_index = next.getIndex();
+        if (blocked[next_index] || step_map[next_index] == STEP_MAX)
+          break;
+        const auto next_g = cost + run_cost(run + i) - run_cost(run);
+        const auto next_s = state(next, d);
+        if (next_g < g[next_s]) {
+          g[next_s] = next_g;
+          parent[next_s] = Parent{s, d, coord_t(i)};
+          open.push(Node{next_g + step_map[next_index], next_g, next_s});
+        }
+        if (is_dest[next_index])
+          break; /*< 目的地で経路を終える */
+      }
+    }
+  }
+  return false;
+}
+Pose StepMap::calcNextDirections(const MazeView &maze, const Pose &start,
                                  Directions &nextDirectionsKnown,
-                                 Directions &nextDirectionCandidates) const {
+                                 Directions &nextDirectionCandidates,
+                                 const CandidateOrder order) const {
   Pose end;
   nextDirectionsKnown = getStepDownDirections(maze, start, end, false, true);
-  nextDirectionCandidates = getNextDirectionCandidates(maze, end);
+  nextDirectionCandidates = getNextDirectionCandidates(maze, end, order);
   return end;
 }
-Directions StepMap::getStepDownDirections(const Maze &maze, const Pose &start,
-                                          Pose &end, const bool known_only,
+Directions StepMap::getStepDownDirections(const MazeView &maze,
+                                          const Pose &start, Pose &end,
+                                          const bool known_only,
                                           const bool break_unknown) const {
   /* ステップマップから既知区間進行方向列を生成 */
   Directions shortest_dirs;
@@ -228,7 +579,7 @@ Directions StepMap::getStepDownDirections(const Maze &maze, const Pose &start,
     auto min_step = STEP_MAX;
     for (const auto d : Direction::Along4) {
       auto next = end.p; /*< 隣接 */
-      for (int8_t i = 1; i < MAZE_SIZE; ++i) {
+      for (int i = 1; i < MAZE_SIZE; ++i) {
         /* 壁あり or 既知壁のみで未知壁 ならば次へ */
         if (maze.isWall(next, d) || (known_only && !maze.isKnown(next, d)))
           break;
@@ -255,8 +606,9 @@ Directions StepMap::getStepDownDirections(const Maze &maze, const Pose &start,
   }
   return shortest_dirs;
 }
-Directions StepMap::getNextDirectionCandidates(const Maze &maze,
-                                               const Pose &focus) const {
+Directions
+StepMap::getNextDirectionCandidates(const MazeView &maze, const Pose &focus,
+                                    const CandidateOrder order) const {
   /* 直線優先で進行方向の候補を抽出．全方位 STEP_MAX だと空になる */
   Directions dirs;
   for (const auto d : {focus.d + Direction::Front, focus.d + Direction::Left,
@@ -268,20 +620,18 @@ Directions StepMap::getNextDirectionCandidates(const Maze &maze,
             [&](const Direction d1, const Direction d2) {
               return getStep(focus.p.next(d1)) < getStep(focus.p.next(d2));
             });
-#if 1
   /* 未知壁優先で並べ替え(未知壁同士ならばコストが低い順) */
-  std::sort(dirs.begin(), dirs.end(),
-            [&](const Direction d1, const Direction d2) {
-              return (maze.unknownCount(focus.p.next(d1)) &&
-                      !maze.unknownCount(focus.p.next(d2)));
-            });
-#endif
-#if 1
+  if (order == StraightFirst || order == UnknownFirst)
+    std::sort(dirs.begin(), dirs.end(),
+              [&](const Direction d1, const Direction d2) {
+                return (maze.unknownCount(focus.p.next(d1)) &&
+                        !maze.unknownCount(focus.p.next(d2)));
+              });
   /* 直進優先に並べ替え */
-  std::sort(dirs.begin(), dirs.end(),
-            [&](const Direction d1, const Direction d2
-                __attribute__((unused))) { return d1 == focus.d; });
-#endif
+  if (order == StraightFirst)
+    std::sort(dirs.begin(), dirs.end(),
+              [&](const Direction d1, const Direction d2
+                  __attribute__((unused))) { return d1 == focus.d; });
   return dirs;
 }
 void StepMap::appendStraightDirections(const Maze &maze,
@@ -322,41 +672,5 @@ void StepMap::appendStraightDirections(const Maze &maze,
     }
   }
 }
-/**
- * @brief 台形加速を考慮したコストを生成する関数
- *
- * @param i マスの数
- * @param am 最大加速度
- * @param vs 始点速度
- * @param vm 飽和速度
- * @param seg 1マスの長さ
- * @return StepMap::step_t コスト
- */
-static StepMap::step_t gen_cost_impl(const int i, const float am,
-                                     const float vs, const float vm,
-                                     const float seg) {
-  const auto d = seg * i; /*< i 区画分の走行距離 */
-  /* グラフの面積から時間を求める */
-  const auto d_thr = (vm * vm - vs * vs) / am; /*< 最大速度に達する距離 */
-  if (d < d_thr)
-    return 2 * (std::sqrt(vs * vs + am * d) - vs) / am * 1000; /*< 三角加速 */
-  else
-    return (am * d + (vm - vs) * (vm - vs)) / (am * vm) * 1000; /*< 台形加速 */
-}
-void StepMap::calcStraightStepTable() {
-  const float vs = 420.0f;       /*< 基本速度 [mm/s] */
-  const float am_a = 4200.0f;    /*< 最大加速度 [mm/s/s] */
-  const float vm_a = 1500.0f;    /*< 飽和速度 [mm/s] */
-  const float seg_a = 90.0f;     /*< 区画の長さ [mm] */
-  const float t_slalom = 287.0f; /*< 小回り90度ターンの時間 [ms] */
-  step_table[0] = 0;             /*< [0] は使用しない */
-  for (int i = 1; i < MAZE_SIZE; ++i)
-    step_table[i] =
-        (step_t)t_slalom + gen_cost_impl(i - 1, am_a, vs, vm_a, seg_a);
-  /* 最大値を超えないようにスケーリング */
-  const float scaling_factor = 2;
-  for (int i = 0; i < MAZE_SIZE; ++i)
-    step_table[i] /= scaling_factor;
-}
 
 } // namespace MazeLib
@@ -0,0 +1,42 @@
+/**
+ * @file StepMapAnytime.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 計算量の上限を指定して分割して更新できるステップマップ
+ * @date 2026.10.19
+ */
+#include "StepMapAnytime.h"
+
+namespace MazeLib {
+
+void StepMapAnytime::start(const Positions &dest, const bool known_only,
+                           const bool simple) {
+  this->known_only = known_only;
+  this->simple = simple;
+  expansion_count = 0;
+  /* 全区画のステップを最大値に設定し，destのステップを0とする */
+  reset();
+  q.clear();
+  for (const auto p : dest)
+    if (p.isInsideOfField())
+      setStep(p, 0), q.push(p.getIndex());
+}
+bool StepMapAnytime::resume(const MazeView &maze, const int max_expansions) {
+  for (int n = 0; n < max_expansions && !q.empty(); ++n) {
+    const auto focus = q.pop();
+    relaxFrom(maze, focus, known_only, simple, nullptr, q);
+    ++expansion_count;
+  }
+  return q.empty();
+}
+Directions StepMapAnytime::calcBestDirections(const MazeView &maze,
+                                              const Position &start) const {
+  if (getStep(start) == STEP_MAX)
+    return {};
+  /* 途中のステップも経路のコストなので，下っていけば目的地に着く */
+  Pose end;
+  const auto dirs = getStepDownDirections(maze, {start, Direction::Max}, end,
+                                          known_only, false);
+  return getStep(end.p) == 0 ? dirs : Directions{};
+}
+
+} // namespace MazeLib
@@ -0,0 +1,109 @@
+/**
+ * @file StepMapDual.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 既知壁のみと未知壁を壁なしとした2つのステップマップを扱うクラス
+ * @date 2026.10.19
+ */
+#include "StepMapDual.h"
+
+namespace MazeLib {
+
+void StepMapDual::calcShortestDirections(const MazeView &maze,
+                                         const Position &start,
+                                         const Positions &dest,
+                                         const bool simple,
+                                         const DeadEndMap &dead_end,
+                                         Directions &optimistic_dirs,
+                                         Directions &known_dirs) {
+  update(maze, dest, simple, dead_end, start);
+  optimistic_dirs = stepDown(optimistic, maze, start, false);
+  known_dirs = stepDown(known, maze, start, true);
+}
+void StepMapDual::updateImpl(const MazeView &maze, const Positions &dest,
+                             const bool simple,
+                             const std::bitset<Position::SIZE> *enterable) {
+  /* マップの番号と，更新予約に記録するビット */
+  enum : uint8_t { OPTIMISTIC = 1, KNOWN = 2 };
+  step_t *const optimistic_map = optimistic.step_map.data();
+  step_t *const known_map = known.step_map.data();
+  /* 直線優先 */
+  const int max_straight = simple ? 1 : MAZE_SIZE * 2;
+  const auto *step_table = optimistic.step_table;
+  /* 全区画のステップを最大値に設定 */
+  optimistic.reset(), known.reset();
+  /* 隣接区画と壁の通し番号の表，壁のビット列 */
+  const auto &table = NeighborTable::Table;
+  const auto &wall_bits = maze.getWallBits();
+  const auto &known_bits = maze.getKnownBits();
+  /* ステップの更新予約のキュー．どちらのマップの更新によるものかは
+   * queued_lanes に重ねて記録し，同じ区画の予約は重複させない */
+  auto &q = optimistic.getQueue();
+  const auto push = [&](const index_t i, const uint8_t lanes) {
+    queued_lanes[i] |= lanes, q.push(i);
+  };
+  /* destのステップを0とする */
+  for (const auto p : dest)
+    if (p.isInsideOfField())
+      optimistic.setStep(p, 0), known.setStep(p, 0),
+          push(p.getIndex(), OPTIMISTIC | KNOWN);
+  /* ステップの更新がなくなるまで更新処理 */
+  while (!q.empty()) {
+    /* 注目する区画を取得．ステップは取り出したときの値で展開する */
+    const auto focus_index = q.pop();
+    const auto focus_lanes = queued_lanes[focus_index];
+    queued_lanes[focus_index] = 0;
+    const auto optimistic_step = optimistic_map[focus_index];
+    const auto known_step = known_map[focus_index];
+    /* 周辺を走査 */
+    for (int d = 0; d < 4; ++d) {
+      /* 直線で行けるところまで更新する．lanes は更新を続けるマップ */
+      uint8_t lanes = focus_lanes;
+      auto next_index = focus_index;
+      for (int i = 1; i <= max_straight; ++i) {
+        /* 外周 or 壁あり ならば次へ．未知壁ならば既知壁のみのマップは次へ */
+        const auto next_wi = table.wall[next_index][d];
+        if (next_wi == NeighborTable::OUTSIDE || wall_bits[next_wi])
+          break;
+        if (!known_bits[next_wi])
+          lanes &= ~KNOWN;
+        if (!lanes)
+          break;
+        next_index = table.cell[next_index][d]; /*< 移動 */
+        /* 展開しない区画 (袋小路) ならば次へ */
+        if (enterable && !(*enterable)[next_index])
+          break;
+        /* 直線加速を考慮したステップを算出し，マップごとに更新 */
+        const auto cost = simple ? 1 : step_table[i];
+        uint8_t updated = 0;
+        if (lanes & OPTIMISTIC) {
+          const auto next_step = StepMap::addStep(optimistic_step, cost);
+          if (optimistic_map[next_index] <= next_step)
+            lanes &= ~OPTIMISTIC; /*< 更新の必要がない */
+          else
+            optimistic_map[next_index] = next_step, updated |= OPTIMISTIC;
+        }
+        if (lanes & KNOWN) {
+          const auto next_step = StepMap::addStep(known_step, cost);
+          if (known_map[next_index] <= next_step)
+            lanes &= ~KNOWN; /*< 更新の必要がない */
+          else
+            known_map[next_index] = next_step, updated |= KNOWN;
+        }
+        if (!updated)
+          break;
+        /* 再帰的に更新され得るのでキューにプッシュ */
+        push(next_index, updated);
+      }
+    }
+  }
+}
+Directions StepMapDual::stepDown(const StepMap &step_map, const MazeView &maze,
+                                 const Position &start, const bool known_only) {
+  Pose end;
+  const auto dirs = step_map.getStepDownDirections(
+      maze, {start, Direction::Max}, end, known_only, false);
+  /* ゴール判定 */
+  return step_map.getStep(end.p) == 0 ? dirs : Directions{};
+}
+
+} // namespace MazeLib
@@ -0,0 +1,114 @@
+/**
+ * @file StepMapMulti.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 複数の目的地のステップマップを同時に扱うクラス
+ * @date 2026.10.19
+ */
+#include "StepMapMulti.h"
+
+#include <cstring>     /*< for std::memcpy */
+#include <type_traits> /*< for std::make_signed */
+
+namespace MazeLib {
+
+/** @brief ベクトルの比較結果 (真のレーンは全ビット1) */
+typedef std::make_signed<StepMapMulti::step_t>::type mask_elem_t;
+typedef mask_elem_t mask_vec_t
+    __attribute__((vector_size(sizeof(mask_elem_t) * StepMapMulti::LANES)));
+
+/** @brief 真のレーンが1つでもあるかどうか */
+static bool any(const mask_vec_t m) {
+  uint64_t w[sizeof(m) / sizeof(uint64_t)];
+  std::memcpy(w, &m, sizeof(m));
+  uint64_t r = 0;
+  for (const auto v : w)
+    r |= v;
+  return r;
+}
+
+void StepMapMulti::reset() {
+  step_vec_t max;
+  for (int k = 0; k < LANES; ++k)
+    max[k] = StepMap::STEP_MAX;
+  step_map.fill(max);
+}
+void StepMapMulti::update(const MazeView &maze,
+                          const std::vector<Positions> &dests,
+                          const bool known_only, const bool simple) {
+  /* 直線優先 */
+  const int max_straight = simple ? 1 : MAZE_SIZE * 2;
+  /* 全区画のステップを最大値に設定 */
+  reset();
+  lane_count = std::min<int>(dests.size(), int(LANES));
+  /* 壁の参照は全レーンで共通なので，各区画の通過可能な方向を先に求める */
+  std::array<uint8_t, Position::SIZE> open;
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+      const auto p = Position(x, y);
+      uint8_t bits = 0;
+      for (const auto d : Direction::Along4)
+        if (!maze.isWall(p, d) && !(known_only && !maze.isKnown(p, d)))
+          bits |= 1 << (d / 2);
+      open[p.getIndex()] = bits;
+    }
+  /* 隣接区画の通し番号の表 */
+  const auto &table = NeighborTable::Table;
+  /* ステップの更新予約のキュー．区画の通し番号を持つ */
+  StepQueue q;
+  /* destのステップを0とする */
+  for (int k = 0; k < lane_count; ++k)
+    for (const auto p : dests[k])
+      if (p.isInsideOfField())
+        step_map[p.getIndex()][k] = 0, q.push(p.getIndex());
+  /* ステップの更新がなくなるまで更新処理 */
+  while (!q.empty()) {
+    /* 注目する区画を取得 */
+    const int focus = q.pop();
+    const auto focus_step = step_map[focus];
+    /* 到達済みのレーン */
+    const mask_vec_t reached = focus_step != StepMap::STEP_MAX;
+    /* 周辺を走査 */
+    for (int d = 0; d < 4; ++d) {
+      /* 直線で行けるところまで更新する．alive は更新を続けるレーン */
+      auto alive = reached;
+      int next = focus;
+      for (int i = 1; i <= max_straight; ++i) {
+        /* 壁あり or 既知壁のみで未知壁 ならば次へ */
+        if (!(open[next] >> d & 1))
+          break;
+        next = table.cell[next][d]; /*< 移動 */
+        /* 直線加速を考慮したステップを算出し，小さいレーンを更新 */
+        const step_t cost = simple ? 1 : step_table[i];
+        /* 溢れたレーンは STEP_MAX に飽和させる */
+        step_vec_t next_step = focus_step + cost;
+        next_step |= (step_vec_t)(next_step < focus_step);
+        auto &step = step_map[next];
+        alive &= (mask_vec_t)(next_step < step);
+        if (!any(alive))
+          break; /*< 更新の必要がない */
+        step = (step_vec_t)((mask_vec_t)next_step & alive) |
+               (step_vec_t)((mask_vec_t)step & ~alive); /*< 更新 */
+        q.push(next); /*< 再帰的に更新され得るのでキューにプッシュ */
+      }
+    }
+  }
+}
+void StepMapMulti::copyLane(const int lane, StepMap &out) const {
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y)
+      out.setStep(x, y, getStep(lane, Position(x, y)));
+}
+Directions StepMapMulti::calcShortestDirections(const int lane,
+                                                const MazeView &maze,
+                                                const Position &start,
+                                                const bool known_only) const {
+  StepMap step_map_lane;
+  copyLane(lane, step_map_lane);
+  Pose end;
+  const auto dirs = step_map_lane.getStepDownDirections(
+      maze, {start, Direction::Max}, end, known_only, false);
+  /* ゴール判定 */
+  return step_map_lane.getStep(end.p) == 0 ? dirs : Directions{};
+}
+
+} // namespace MazeLib
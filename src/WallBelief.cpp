@@ -0,0 +1,56 @@
+/**
+ * @file WallBelief.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 壁の有無の確からしさを対数オッズで保持するクラス
+ * @date 2026.10.19
+ */
+#include "WallBelief.h"
+
+#include <algorithm> /*< for std::min, std::max */
+
+namespace MazeLib {
+
+void WallBelief::reset(const MazeView &maze) {
+  reset();
+  const auto &known = maze.getKnownBits();
+  const auto &wall = maze.getWallBits();
+  forEachSetBit(known, [&](const size_t i) {
+    log_odds[i] = wall[i] ? config.saturation : -config.saturation;
+  });
+}
+bool WallBelief::update(Maze &maze, const Position p, const Direction d,
+                        const bool b) {
+  const auto i = WallIndex(p, d);
+  if (!i.isInsideOfField())
+    return maze.updateWall(p, d, b); /*< 迷路外は Maze と同じ扱い */
+  /* 観測を飽和加算 */
+  auto &l = log_odds[i.getIndex()];
+  const int next = b ? l + config.hit : l - config.miss;
+  l = std::max<int>(-config.saturation, std::min<int>(config.saturation, next));
+  /* 閾値による判定を迷路に反映．壁ログに残すため updateWall() を使う */
+  const bool known = isKnown(i), wall = isWall(i);
+  if (maze.isKnown(i) && (!known || maze.isWall(i) != wall))
+    maze.updateWall(p, d, !maze.isWall(i)); /*< 食い違いとして未知壁にする */
+  if (known && !maze.isKnown(i))
+    maze.updateWall(p, d, wall);
+  return known && wall == b;
+}
+void WallBelief::resetLastWalls(Maze &maze, const int num) {
+  const auto &records = maze.getWallRecords();
+  for (int n = 0; n < num && n < int(records.size()); ++n) {
+    const auto &wr = records[records.size() - 1 - n];
+    const auto i = WallIndex(wr.getPosition(), wr.getDirection());
+    if (i.isInsideOfField())
+      log_odds[i.getIndex()] = 0;
+  }
+  maze.resetLastWalls(num);
+  /* 残った壁ログにより既知のままの壁は，閾値の値で既知とする */
+  const auto &known = maze.getKnownBits();
+  const auto &wall = maze.getWallBits();
+  forEachSetBit(known, [&](const size_t i) {
+    if (std::abs(log_odds[i]) < config.known_threshold)
+      log_odds[i] = wall[i] ? config.known_threshold : -config.known_threshold;
+  });
+}
+
+} // namespace MazeLib
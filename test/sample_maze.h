@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Maze.h"
+
+#include <sstream>
+
+namespace MazeLib {
+
+/** @brief 各テストで共通の 9x9 の迷路 */
+inline Maze getSampleMaze() {
+  std::stringstream maze_stream;
+  maze_stream << R"(
++---+---+---+---+---+---+---+---+---+
+|               |                   |
++   +---+   +   +   +---+---+---+   +
+|       |   |   |   |               |
++---+   +   +   +   +   +---+---+---+
+|       |   |       |               |
++   +---+   +---+---+---+---+---+   +
+|       |   | G   G   G |           |
++---+   +   +   +   +   +   +---+---+
+|       |   | G   G   G |           |
++   +---+   +   +   +   +---+---+   +
+|       |   | G   G   G |       |   |
++---+   +   +   +---+---+   +   +   +
+|       |   |   |       |   |   |   |
++   +---+   +   +   +   +   +   +   +
+|       |   |   |   |   |   |   |   |
++   +   +   +   +   +   +   +   +   +
+|   | S |   |       |       |       |
++---+---+---+---+---+---+---+---+---+
+)";
+  Maze maze;
+  maze_stream >> maze;
+  return maze;
+}
+
+} // namespace MazeLib
@@ -0,0 +1,84 @@
+#include "CostModel.h"
+#include "StepMap.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace MazeLib;
+
+/* 浮動小数点数による従来のコスト算出 */
+static uint16_t float_reference(const int i, const CostModel &m) {
+  if (i == 0)
+    return 0;
+  const float vs = m.vs, am = m.am, vm = m.vm, seg = m.seg;
+  const auto d = seg * (i - 1);
+  const auto d_thr = (vm * vm - vs * vs) / am;
+  const uint16_t t =
+      d < d_thr ? 2 * (std::sqrt(vs * vs + am * d) - vs) / am * 1000
+                : (am * d + (vm - vs) * (vm - vs)) / (am * vm) * 1000;
+  return uint16_t(m.t_slalom + t) / m.scaling;
+}
+
+TEST(CostModel, constexpr) {
+  constexpr auto table = CostModel().makeTable();
+  static_assert(table[0] == 0, "");
+  static_assert(table[1] == 287 / 2, "");
+  static_assert(CostModel::isqrt(0) == 0, "");
+  static_assert(CostModel::isqrt(99) == 9, "");
+  static_assert(CostModel::isqrt(100) == 10, "");
+  for (int i = 0; i < MAZE_SIZE; ++i)
+    EXPECT_EQ(table[i], CostModel::DefaultTable[i]);
+}
+TEST(CostModel, float_reference) {
+  const CostModel models[] = {
+      CostModel(),
+      {300, 3000, 1200, 90, 300, 2},
+      {500, 9000, 3000, 90, 250, 3},
+  };
+  for (const auto &m : models) {
+    const auto table = m.makeTable();
+    for (int i = 0; i < MAZE_SIZE; ++i)
+      EXPECT_EQ(table[i], float_reference(i, m)) << i;
+    /* 単調増加 */
+    for (int i = 2; i < MAZE_SIZE; ++i)
+      EXPECT_LE(table[i - 1], table[i]);
+  }
+}
+TEST(CostModel, parse) {
+  CostModel m;
+  std::stringstream ss("am 9000\nvm 3000\n");
+  EXPECT_TRUE(m.parse(ss));
+  EXPECT_EQ(m.am, 9000u);
+  EXPECT_EQ(m.vm, 3000u);
+  EXPECT_EQ(m.vs, CostModel().vs);
+  std::stringstream bad1("am");
+  EXPECT_FALSE(m.parse(bad1));
+  std::stringstream bad2("unknown 1");
+  EXPECT_FALSE(m.parse(bad2));
+  std::stringstream bad3("scaling 0");
+  EXPECT_FALSE(m.parse(bad3));
+  EXPECT_EQ(m.am, 9000u);
+  EXPECT_EQ(m.scaling, CostModel().scaling);
+}
+TEST(CostModel, StepMap) {
+  const Maze maze;
+  const Positions dest = {Position(0, 0)};
+  const auto step = [&](const StepMap &step_map) {
+    return step_map.getStep(Position(0, 15));
+  };
+  StepMap step_map;
+  step_map.update(maze, dest, false, false);
+  EXPECT_EQ(step(step_map), CostModel::DefaultTable[15]);
+  /* 実行時に読み込んだパラメータのテーブル */
+  CostModel m;
+  std::stringstream ss("t_slalom 1000 scaling 1");
+  ASSERT_TRUE(m.parse(ss));
+  const auto table = m.makeTable();
+  StepMap step_map_custom(table);
+  step_map_custom.update(maze, dest, false, false);
+  EXPECT_EQ(step(step_map_custom), table[15]);
+  step_map.setCostTable(table);
+  step_map.update(maze, dest, false, false);
+  EXPECT_EQ(step(step_map), table[15]);
+}
@@ -0,0 +1,117 @@
+#include "DeadEndMap.h"
+#include "MazeGenerator.h"
+#include "StepMap.h"
+#include "gtest/gtest.h"
+#include "sample_maze.h"
+#include <algorithm>
+
+using namespace MazeLib;
+
+TEST(DeadEndMap, update) {
+  const auto maze = getSampleMaze();
+  DeadEndMap dead_end;
+  EXPECT_EQ(dead_end.count(), 0u);
+  dead_end.update(maze);
+  /* 9x9 の外側は封鎖領域，内側の行き止まりは袋小路 */
+  EXPECT_TRUE(dead_end.isDeadEnd(Position(10, 10)));
+  EXPECT_TRUE(dead_end.isDeadEnd(Position(0, 0)));
+  EXPECT_FALSE(dead_end.isDeadEnd(maze.getStart()));
+  for (const auto p : maze.getGoals())
+    EXPECT_FALSE(dead_end.isDeadEnd(p));
+}
+
+TEST(DeadEndMap, updateWall) {
+  /* 壁をひとつずつ更新したときの差分更新が再計算と一致する */
+  const auto maze_target = getSampleMaze();
+  Maze maze(maze_target.getGoals(), maze_target.getStart());
+  DeadEndMap dead_end;
+  dead_end.update(maze);
+  for (coord_t y = 0; y < 9; ++y)
+    for (coord_t x = 0; x < 9; ++x)
+      for (const auto d : {Direction::East, Direction::North}) {
+        const auto b = maze_target.isWall(x, y, d);
+        maze.updateWall(Position(x, y), d, b);
+        dead_end.updateWall(maze, WallIndex(Position(x, y), d));
+        DeadEndMap expected;
+        expected.update(maze);
+        for (int i = 0; i < Position::SIZE; ++i) {
+          const auto p = Position(i >> MAZE_SIZE_BIT, i & (MAZE_SIZE_MAX - 1));
+          EXPECT_EQ(dead_end.isDeadEnd(p), expected.isDeadEnd(p));
+        }
+      }
+  /* 既知壁と食い違った壁は未知壁となり再計算される */
+  maze.updateWall(Position(0, 0), Direction::East, false);
+  dead_end.updateWall(maze, WallIndex(Position(0, 0), Direction::East));
+  EXPECT_FALSE(dead_end.isDeadEnd(Position(0, 0)));
+}
+TEST(DeadEndMap, updateWall_generated) {
+  /* 生成した迷路の壁を無作為な順に更新しても，差分更新が再計算と一致する */
+  for (const auto style : {MazeGenerator::Perfect, MazeGenerator::Braided})
+    for (const int seed : {1, 2, 3}) {
+      Maze maze_target;
+      MazeGenerator generator(seed);
+      MazeGenerator::Config config;
+      config.style = style;
+      generator.generate(maze_target, config);
+      /* 壁を追加して，到達できない領域を作る */
+      WallIndexes walls;
+      for (int i = 0; i < WallIndex::SIZE; ++i)
+        if (WallIndex(index_t(i)).isInsideOfField()) {
+          walls.push_back(WallIndex(index_t(i)));
+          if (generator.random(100) < 15)
+            maze_target.setWall(walls.back(), true);
+        }
+      for (size_t i = walls.size() - 1; i > 0; --i)
+        std::swap(walls[i], walls[generator.random(i + 1)]);
+      Maze maze(maze_target.getGoals(), maze_target.getStart());
+      DeadEndMap dead_end;
+      dead_end.update(maze);
+      for (const auto i : walls) {
+        maze.updateWall(i.getPosition(), i.getDirection(),
+                        maze_target.isWall(i));
+        dead_end.updateWall(maze, i);
+        DeadEndMap expected;
+        expected.update(maze);
+        ASSERT_EQ(dead_end.count(), expected.count());
+        /* 袋小路の出口をたどって進入できる区画も一致する */
+        for (int k = 0; k < Position::SIZE; k += 7) {
+          const auto p = Position(k >> MAZE_SIZE_BIT, k & (MAZE_SIZE_MAX - 1));
+          ASSERT_EQ(dead_end.getEnterableCells({p}),
+                    expected.getEnterableCells({p}));
+        }
+      }
+    }
+}
+
+TEST(DeadEndMap, StepMap_update) {
+  /* 袋小路を除外しても最短経路は変わらず，展開される区画は減る */
+  const auto maze = getSampleMaze();
+  DeadEndMap dead_end;
+  dead_end.update(maze);
+  StepMap step_map;
+  for (const auto known_only : {true, false})
+    for (const auto simple : {true, false})
+      for (coord_t x = 0; x < 9; ++x)
+        for (coord_t y = 0; y < 9; ++y) {
+          const auto start = Position(x, y);
+          const auto expected = step_map.calcShortestDirections(
+              maze, start, maze.getGoals(), known_only, simple);
+          const auto expected_step = step_map.getStep(start);
+          const auto actual = step_map.calcShortestDirections(
+              maze, start, maze.getGoals(), known_only, simple, dead_end);
+          EXPECT_EQ(expected, actual);
+          EXPECT_EQ(expected_step, step_map.getStep(start));
+        }
+  /* 展開された区画の数 */
+  const auto count = [&]() {
+    const auto &array = step_map.getMapArray();
+    return std::count_if(array.cbegin(), array.cend(), [](const auto step) {
+      return step != StepMap::STEP_MAX;
+    });
+  };
+  step_map.update(maze, {maze.getStart()}, false, false);
+  const auto count_full = count();
+  step_map.update(maze, {maze.getStart()}, false, false, dead_end,
+                  maze.getGoals()[0]);
+  EXPECT_LT(count(), count_full);
+}
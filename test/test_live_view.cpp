@@ -0,0 +1,58 @@
+#include "LiveView.h"
+#include "StepMap.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+using namespace MazeLib;
+
+TEST(LiveView, diff) {
+  Maze maze;
+  StepMap step_map;
+  step_map.update(maze, {Position(0, 0)}, false, true);
+  LiveView live_view(0, false);
+  /* 最初のフレームは画面全体 */
+  std::stringstream ss1;
+  EXPECT_TRUE(live_view.draw(maze, step_map, Directions{}, Position(0, 0),
+                             "status", ss1));
+  EXPECT_EQ(ss1.str().find("\x1b[2J"), 0u);
+  EXPECT_NE(ss1.str().find("status"), std::string::npos);
+  const auto full_size = ss1.str().size();
+  /* 変化がなければ状態表示の行のみ */
+  std::stringstream ss2;
+  EXPECT_TRUE(live_view.draw(maze, step_map, Directions{}, Position(0, 0),
+                             "status", ss2));
+  EXPECT_EQ(ss2.str(), "\x1b[" + std::to_string(2 * MAZE_SIZE + 2) +
+                           ";1Hstatus\x1b[K\n");
+  /* 壁を1枚変えると，その壁のみ描画される */
+  maze.updateWall(Position(1, 0), Direction::East, true);
+  std::stringstream ss3;
+  EXPECT_TRUE(live_view.draw(maze, step_map, Directions{}, Position(0, 0),
+                             "status", ss3));
+  const auto row = 2 * MAZE_SIZE;   /*< 下から2行目 (1始まり) */
+  const auto col = 2 * (1 + 3) + 1; /*< 2区画の次 (1始まり) */
+  EXPECT_EQ(ss3.str().find("\x1b[" + std::to_string(row) + ";" +
+                           std::to_string(col) + "H|"),
+            0u);
+  EXPECT_LT(ss3.str().size(), full_size / 10);
+  EXPECT_EQ(live_view.getFrameCount(), 3u);
+}
+TEST(LiveView, fps) {
+  const Maze maze;
+  StepMap step_map;
+  LiveView live_view(0.001f, false);
+  std::stringstream ss;
+  EXPECT_TRUE(live_view.draw(maze, step_map, Position(0, 1), Direction::North,
+                             "", ss));
+  EXPECT_FALSE(live_view.draw(maze, step_map, Position(0, 1),
+                              Direction::North, "", ss));
+  EXPECT_TRUE(live_view.draw(maze, step_map, Position(0, 1), Direction::North,
+                             "", ss, true));
+  EXPECT_EQ(live_view.getFrameCount(), 2u);
+  /* 全体の再描画 */
+  live_view.reset();
+  std::stringstream ss_full;
+  EXPECT_TRUE(live_view.draw(maze, step_map, Position(0, 1), Direction::North,
+                             "", ss_full));
+  EXPECT_EQ(ss_full.str().find("\x1b[2J"), 0u);
+}
@@ -1,5 +1,7 @@
 #include "Maze.h"
+#include "StepMap.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 
 using namespace MazeLib;
 
@@ -81,3 +83,264 @@ TEST(Maze, parse_from_string_array) {
   sample.print(of, maze_size);
   sample.print(std::cout, maze_size);
 }
+
+TEST(Maze, mergeWalls) {
+  /* 食い違う壁 c，自身のみ既知の壁 a，引数の迷路のみ既知の壁 b */
+  const auto c = WallIndex(Position(2, 2), Direction::East);
+  const auto a = WallIndex(Position(3, 1), Direction::North);
+  const auto b = WallIndex(Position(5, 6), Direction::East);
+  Maze own, other;
+  own.updateWall(c.getPosition(), c.getDirection(), true);
+  own.updateWall(a.getPosition(), a.getDirection(), true);
+  other.updateWall(c.getPosition(), c.getDirection(), false);
+  other.updateWall(b.getPosition(), b.getDirection(), true);
+  EXPECT_EQ(own.getConflictWalls(other), WallIndexes{c});
+  EXPECT_EQ(other.getConflictWalls(own), WallIndexes{c});
+  EXPECT_TRUE(own.getConflictWalls(own).empty());
+  for (const auto policy : {Maze::KeepOwn, Maze::TakeOther, Maze::MarkUnknown,
+                            Maze::PreferWall}) {
+    Maze merged = own;
+    EXPECT_EQ(merged.mergeWalls(other, policy), WallIndexes{c});
+    EXPECT_TRUE(merged.isKnown(a) && merged.isWall(a));
+    EXPECT_TRUE(merged.isKnown(b) && merged.isWall(b));
+    EXPECT_EQ(merged.isKnown(c), policy != Maze::MarkUnknown);
+    EXPECT_EQ(merged.isWall(c),
+              policy == Maze::KeepOwn || policy == Maze::PreferWall);
+    EXPECT_GE(merged.getMaxX(), 5);
+    EXPECT_GE(merged.getMaxY(), 6);
+    /* 統合後は食い違いがない */
+    if (policy == Maze::TakeOther) {
+      EXPECT_TRUE(merged.getConflictWalls(other).empty());
+    }
+  }
+}
+
+TEST(Maze, MazeView) {
+  Maze maze({Position(0, 3)});
+  maze.updateWall(Position(1, 1), Direction::North, true);
+  /* 壁情報のみの複製．ゴール区画や壁ログは持たない */
+  MazeView view = maze;
+  EXPECT_TRUE(view.isKnown(Position(1, 1), Direction::North));
+  EXPECT_TRUE(view.isWall(Position(1, 1), Direction::North));
+  EXPECT_EQ(view.getWallBits(), maze.getWallBits());
+  EXPECT_EQ(view.getKnownBits(), maze.getKnownBits());
+  EXPECT_EQ(view.getMaxX(), maze.getMaxX());
+  /* 直進で3区画 */
+  StepMap step_map;
+  const auto dirs = step_map.calcShortestDirections(
+      view, maze.getStart(), maze.getGoals(), false, true);
+  EXPECT_EQ(dirs, Directions(3, Direction::North));
+  /* 仮の壁を置いた経路の評価は元の迷路に影響しない */
+  view.setWall(Position(0, 1), Direction::North, true);
+  view.setKnown(Position(0, 1), Direction::North, true);
+  EXPECT_GT(step_map
+                .calcShortestDirections(view, maze.getStart(),
+                                        maze.getGoals(), false, true)
+                .size(),
+            dirs.size());
+  EXPECT_FALSE(maze.isKnown(Position(0, 1), Direction::North));
+  EXPECT_EQ(step_map.calcShortestDirections(maze, maze.getStart(),
+                                            maze.getGoals(), false, true),
+            dirs);
+}
+
+TEST(Maze, WallRecordLog) {
+  /* 容量 4 のリングバッファ */
+  WallRecordLog log(4, WallRecordLog::OverwriteOldest);
+  for (int i = 0; i < 6; ++i)
+    log.push_back(WallRecord(i, 0, Direction::North, true));
+  EXPECT_TRUE(log.full());
+  EXPECT_EQ(log.getBegin(), 2u);
+  EXPECT_EQ(log.getEnd(), 6u);
+  EXPECT_EQ(log.getDroppedCount(), 2u);
+  EXPECT_EQ(log[0].getPosition(), Position(2, 0));
+  EXPECT_EQ(log[3].getPosition(), Position(5, 0));
+  /* 巻き戻しは番号を空け，続けて追加しても番号を再利用しない */
+  log.pop_back();
+  EXPECT_EQ(log.size(), 3u);
+  EXPECT_GT(log.getBegin(), 6u);
+  log.push_back(WallRecord(6, 0, Direction::North, true));
+  EXPECT_GT(log.getEnd(), 7u);
+  EXPECT_EQ(log[3].getPosition(), Position(6, 0));
+  /* 消去は番号を空ける */
+  log.clear();
+  EXPECT_TRUE(log.empty());
+  EXPECT_GT(log.getBegin(), 5u);
+  /* 記録を捨てると，保持している記録を残して番号を空ける */
+  log.push_back(WallRecord(0, 1, Direction::North, true));
+  const auto end = log.getEnd();
+  log.drop();
+  EXPECT_GT(log.getBegin(), end);
+  EXPECT_EQ(log.size(), 1u);
+  EXPECT_EQ(log[0].getPosition(), Position(0, 1));
+}
+
+TEST(Maze, compactWallRecords) {
+  for (const auto policy :
+       {WallRecordLog::Compact, WallRecordLog::OverwriteOldest,
+        WallRecordLog::DropNewest}) {
+    Maze maze;
+    maze.setWallRecordsCapacity(24, policy);
+    /* 食い違いによる未知壁への戻しを含めて容量を超えて更新 */
+    for (int i = 0; i < 12; ++i)
+      maze.updateWall(Position(i, 1), Direction::North, true);
+    for (int i = 0; i < 4; ++i) {
+      maze.updateWall(Position(i, 1), Direction::North, false);
+      maze.updateWall(Position(i, 1), Direction::North, true);
+    }
+    maze.updateWall(Position(3, 1), Direction::North, false);
+    for (int i = 0; i < 8; ++i)
+      maze.updateWall(Position(i, 2), Direction::East, i & 1);
+    const auto &log = maze.getWallRecords();
+    EXPECT_LE(log.size(), log.capacity());
+    EXPECT_EQ(log.getDroppedCount() > 0, policy != WallRecordLog::Compact);
+    /* 圧縮した壁ログを順に反映すると同じ迷路が得られる */
+    EXPECT_TRUE(maze.compactWallRecords());
+    EXPECT_EQ(log.size(), maze.getKnownBits().count());
+    Maze replayed;
+    for (size_t i = 0; i < log.size(); ++i)
+      replayed.updateWall(log[i].getPosition(), log[i].getDirection(),
+                          log[i].b);
+    EXPECT_EQ(replayed.getWallBits(), maze.getWallBits());
+    EXPECT_EQ(replayed.getKnownBits(), maze.getKnownBits());
+    EXPECT_FALSE(maze.isKnown(Position(3, 1), Direction::North));
+    /* 容量不足なら圧縮しない */
+    maze.setWallRecordsCapacity(4, policy);
+    EXPECT_FALSE(maze.compactWallRecords());
+  }
+}
+
+TEST(Maze, compactWallRecords_keeps_recent) {
+  Maze maze;
+  maze.setWallRecordsCapacity(48, WallRecordLog::Compact);
+  const auto &log = maze.getWallRecords();
+  WallRecords updates;
+  const auto update = [&](const Position p, const bool b) {
+    maze.updateWall(p, Direction::North, b);
+    updates.push_back(WallRecord(p, Direction::North, b));
+    /* 圧縮の直後も，新しい記録は時系列の順に残る */
+    for (size_t i = 0; i < std::min<size_t>(8, updates.size()); ++i) {
+      const auto &expected = updates[updates.size() - 1 - i];
+      const auto &actual = log[log.size() - 1 - i];
+      EXPECT_EQ(actual.getPosition(), expected.getPosition());
+      EXPECT_EQ(actual.b, expected.b);
+    }
+  };
+  /* 食い違いによる未知壁への戻しを含めて容量を超えて更新 */
+  for (int i = 0; i < 48; ++i) {
+    const auto p = Position(i % 16, 4 + i / 16);
+    update(p, i % 3 == 0);
+    if (i % 5 == 0)
+      update(p, i % 3 != 0);
+  }
+  EXPECT_EQ(log.getDroppedCount(), 0);
+  EXPECT_LT(log.size(), updates.size()); /*< 圧縮された */
+  /* 壁ログを順に反映すると同じ迷路が得られる */
+  Maze replayed;
+  for (size_t i = 0; i < log.size(); ++i)
+    replayed.updateWall(log[i].getPosition(), log[i].getDirection(),
+                        log[i].b);
+  EXPECT_EQ(replayed.getWallBits(), maze.getWallBits());
+  EXPECT_EQ(replayed.getKnownBits(), maze.getKnownBits());
+  /* 巻き戻しは最近に観測した壁を取り消す */
+  Maze expected;
+  for (size_t i = 0; i + 4 < updates.size(); ++i)
+    expected.updateWall(updates[i].getPosition(), updates[i].getDirection(),
+                        updates[i].b);
+  maze.resetLastWalls(4);
+  EXPECT_EQ(maze.getWallBits(), expected.getWallBits());
+  EXPECT_EQ(maze.getKnownBits(), expected.getKnownBits());
+}
+
+TEST(Maze, resetLastWalls_overwritten) {
+  /* 上書きで失われた古い記録の壁は巻き戻しで変わらない */
+  Maze maze;
+  maze.setWallRecordsCapacity(4, WallRecordLog::OverwriteOldest);
+  for (int i = 0; i < 8; ++i)
+    maze.updateWall(Position(i, 2), Direction::North, i & 1);
+  maze.updateWall(Position(1, 2), Direction::North, false); /*< 食い違い */
+  maze.resetLastWalls(3);
+  for (int i = 0; i < 6; ++i)
+    EXPECT_TRUE(maze.isKnown(Position(i, 2), Direction::North)) << i;
+  EXPECT_TRUE(maze.isWall(Position(1, 2), Direction::North));
+  EXPECT_FALSE(maze.isKnown(Position(6, 2), Direction::North));
+  EXPECT_FALSE(maze.isKnown(Position(7, 2), Direction::North));
+}
+
+TEST(Maze, WallRecordLog_default_capacity) {
+  /* 既定の容量は迷路内の壁の総数なので，全壁を更新しても上書きされない */
+  Maze maze;
+  EXPECT_EQ(maze.getWallRecords().capacity(), size_t(WallIndex::SIZE));
+  for (int n = 0; n < 2; ++n)
+    for (int i = 0; i < WallIndex::SIZE; ++i) {
+      const auto wi = WallIndex(index_t(i));
+      maze.updateWall(wi.getPosition(), wi.getDirection(), (i + n) % 3 == 0);
+    }
+  EXPECT_EQ(maze.getWallRecords().getDroppedCount(), 0u);
+}
+
+TEST(Maze, forEachSetBit) {
+  std::bitset<200> bits;
+  const std::vector<size_t> expected = {0, 63, 64, 130, 199};
+  for (const auto i : expected)
+    bits[i] = true;
+  std::vector<size_t> actual;
+  forEachSetBit(bits, [&](const size_t i) { actual.push_back(i); });
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(Maze, backupWallRecordsToFile) {
+  const std::string file_path = "backup.bin";
+  Maze maze;
+  maze.setWallRecordsCapacity(8, WallRecordLog::OverwriteOldest);
+  EXPECT_TRUE(maze.backupWallRecordsToFile(file_path, true));
+  for (int i = 0; i < 12; ++i) {
+    maze.updateWall(Position(i, 3), Direction::East, true);
+    maze.updateWall(Position(i, 3), Direction::East, false); /*< 食い違い */
+    EXPECT_TRUE(maze.backupWallRecordsToFile(file_path));
+  }
+  /* 上書きで失われた記録があっても，復元すると同じ迷路になる */
+  Maze restored;
+  EXPECT_TRUE(restored.restoreWallRecordsFromFile(file_path));
+  EXPECT_EQ(restored.getWallBits(), maze.getWallBits());
+  EXPECT_EQ(restored.getKnownBits(), maze.getKnownBits());
+  /* ファイルの大きさは既知の壁の数で抑えられる */
+  std::ifstream ifs(file_path, std::ifstream::ate);
+  EXPECT_LE(size_t(ifs.tellg()),
+            (maze.getKnownBits().count() + 8) * sizeof(WallRecord));
+}
+
+TEST(Maze, backupWallRecordsToFile_reset_last) {
+  const std::string file_path = "backup.bin";
+  Maze maze;
+  EXPECT_TRUE(maze.backupWallRecordsToFile(file_path, true));
+  for (int i = 0; i < 8; ++i)
+    maze.updateWall(Position(i, 3), Direction::East, true);
+  EXPECT_TRUE(maze.backupWallRecordsToFile(file_path));
+  /* 巻き戻しの直後に別の壁を追加しても，保存し直される */
+  maze.resetLastWalls(1);
+  maze.updateWall(Position(0, 5), Direction::North, true);
+  EXPECT_TRUE(maze.backupWallRecordsToFile(file_path));
+  Maze restored;
+  EXPECT_TRUE(restored.restoreWallRecordsFromFile(file_path));
+  EXPECT_EQ(restored.getWallBits(), maze.getWallBits());
+  EXPECT_EQ(restored.getKnownBits(), maze.getKnownBits());
+}
+
+TEST(Maze, backupWallRecordsToFile_drop_newest) {
+  const std::string file_path = "backup.bin";
+  Maze maze;
+  maze.setWallRecordsCapacity(8, WallRecordLog::DropNewest);
+  EXPECT_TRUE(maze.backupWallRecordsToFile(file_path, true));
+  for (int i = 0; i < 12; ++i) {
+    maze.updateWall(Position(i, 3), Direction::East, i & 1);
+    maze.updateWall(Position(i, 4), Direction::North, true);
+    EXPECT_TRUE(maze.backupWallRecordsToFile(file_path));
+  }
+  EXPECT_GT(maze.getWallRecords().getDroppedCount(), 0u);
+  /* 捨てた記録の壁も復元される */
+  Maze restored;
+  EXPECT_TRUE(restored.restoreWallRecordsFromFile(file_path));
+  EXPECT_EQ(restored.getWallBits(), maze.getWallBits());
+  EXPECT_EQ(restored.getKnownBits(), maze.getKnownBits());
+}
@@ -0,0 +1,88 @@
+#include "StepMap.h"
+#include "gtest/gtest.h"
+#include "maze_c.h"
+
+using namespace MazeLib;
+
+static const char *sample_text = "+---+---+---+\n"
+                                 "|         G |\n"
+                                 "+   +---+---+\n"
+                                 "|           |\n"
+                                 "+   +---+   +\n"
+                                 "| S |       |\n"
+                                 "+---+---+---+\n";
+
+TEST(maze_c, version) {
+  EXPECT_EQ(maze_abi_version(), uint32_t(MAZE_C_ABI_VERSION));
+  EXPECT_EQ(maze_size(), int(MAZE_SIZE));
+  EXPECT_EQ(maze_wall_count(), int(WallIndex::SIZE));
+}
+TEST(maze_c, maze) {
+  maze_maze_t *maze = maze_create();
+  ASSERT_NE(maze, nullptr);
+  EXPECT_TRUE(maze_parse(maze, sample_text));
+  EXPECT_TRUE(maze_is_wall(maze, 0, 0, Direction::East));
+  EXPECT_FALSE(maze_is_wall(maze, 0, 0, Direction::North));
+  EXPECT_TRUE(maze_is_known(maze, 0, 0, Direction::North));
+  /* ビット列はコピーせずに迷路の更新に追従する */
+  size_t nbytes = 0;
+  const uint8_t *walls = maze_wall_bits(maze, &nbytes);
+  const uint8_t *known = maze_known_bits(maze, nullptr);
+  EXPECT_EQ(nbytes, size_t(WallIndex::SIZE / 8));
+  const auto bit = [](const uint8_t *bits, const WallIndex i) {
+    return (bits[i.getIndex() / 8] >> (i.getIndex() % 8)) & 1;
+  };
+  const auto i = WallIndex(Position(5, 5), Direction::East);
+  EXPECT_FALSE(bit(known, i));
+  EXPECT_TRUE(maze_update_wall(maze, 5, 5, Direction::East, 1));
+  EXPECT_TRUE(bit(walls, i));
+  EXPECT_TRUE(bit(known, i));
+  EXPECT_TRUE(maze_update_wall(maze, 5, 5, Direction::East, 1));
+  EXPECT_FALSE(maze_update_wall(maze, 5, 5, Direction::East, 0));
+  EXPECT_FALSE(bit(known, i));
+  for (int n = 0; n < WallIndex::SIZE; ++n) {
+    const auto i = WallIndex(uint16_t(n));
+    if (i.isInsideOfField()) {
+      EXPECT_EQ(bit(walls, i),
+                maze_is_wall(maze, i.x, i.y, i.getDirection()));
+    }
+  }
+  maze_reset(maze);
+  EXPECT_FALSE(maze_is_known(maze, 1, 1, Direction::East));
+  maze_destroy(maze);
+  maze_destroy(nullptr);
+}
+TEST(maze_c, step_map) {
+  maze_maze_t *maze = maze_create();
+  ASSERT_TRUE(maze_parse(maze, sample_text));
+  maze_step_map_t *step_map = maze_step_map_create();
+  ASSERT_NE(step_map, nullptr);
+  const maze_position_t goal = {2, 2};
+  const maze_position_t start = {0, 0};
+  maze_set_start(maze, start);
+  EXPECT_TRUE(maze_set_goals(maze, &goal, 1));
+  int8_t dirs[4];
+  const int32_t length = maze_step_map_shortest(step_map, maze, start, &goal,
+                                                1, true, true, dirs, 4);
+  EXPECT_EQ(length, 4);
+  EXPECT_EQ(dirs[0], Direction::North);
+  EXPECT_EQ(dirs[1], Direction::North);
+  EXPECT_EQ(dirs[2], Direction::East);
+  EXPECT_EQ(dirs[3], Direction::East);
+  /* ステップ配列は StepMap::getMapArray() と同じ並び */
+  EXPECT_TRUE(maze_step_map_update(step_map, maze, &goal, 1, true, true));
+  size_t count = 0;
+  const uint16_t *steps = maze_step_map_array(step_map, &count);
+  EXPECT_EQ(count, size_t(Position::SIZE));
+  EXPECT_EQ(steps[Position(0, 0).getIndex()], 4);
+  EXPECT_EQ(maze_step_map_get_step(step_map, 0, 0), 4);
+  EXPECT_EQ(maze_step_map_get_step(step_map, -1, 0),
+            StepMap::step_t(StepMap::STEP_MAX));
+  /* 既知壁のみでは到達不能 */
+  const maze_position_t sealed = {5, 5};
+  EXPECT_EQ(maze_step_map_shortest(step_map, maze, start, &sealed, 1, true,
+                                   true, dirs, 4),
+            -1);
+  maze_step_map_destroy(step_map);
+  maze_destroy(maze);
+}
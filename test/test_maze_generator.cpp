@@ -0,0 +1,165 @@
+#include "MazeGenerator.h"
+#include "StepMap.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace MazeLib;
+
+/* 大会規定と連結性の確認 */
+static void check_rules(const Maze &maze, const int maze_size,
+                        const int goal_size) {
+  /* スタート区画 */
+  EXPECT_EQ(maze.getStart(), Position(0, 0));
+  EXPECT_TRUE(maze.isWall(0, 0, Direction::East));
+  EXPECT_FALSE(maze.isWall(0, 0, Direction::North));
+  /* ゴール区画の入口は1箇所 */
+  EXPECT_EQ(maze.getGoals().size(), size_t(goal_size * goal_size));
+  int entrances = 0;
+  const auto &goals = maze.getGoals();
+  for (const auto p : goals)
+    for (const auto d : Direction::Along4)
+      if (!maze.isWall(p, d) &&
+          std::find(goals.cbegin(), goals.cend(), p.next(d)) == goals.cend())
+        ++entrances;
+  EXPECT_EQ(entrances, 1);
+  /* 外周と全壁が既知 */
+  for (int8_t i = 0; i < maze_size; ++i) {
+    EXPECT_TRUE(maze.isWall(i, maze_size - 1, Direction::North));
+    EXPECT_TRUE(maze.isWall(maze_size - 1, i, Direction::East));
+    for (int8_t j = 0; j < maze_size; ++j)
+      EXPECT_EQ(maze.unknownCount(Position(i, j)), 0);
+  }
+  /* 柱に壁が1枚以上つく (ゴール区画内を除く) */
+  const auto is_goal = [&](const int8_t x, const int8_t y) {
+    return std::find(goals.cbegin(), goals.cend(), Position(x, y)) !=
+           goals.cend();
+  };
+  for (coord_t x = 1; x < maze_size; ++x)
+    for (coord_t y = 1; y < maze_size; ++y) {
+      if (is_goal(x, y) && is_goal(x - 1, y - 1))
+        continue;
+      EXPECT_TRUE(maze.isWall(x - 1, y, Direction::East) ||
+                  maze.isWall(x - 1, y - 1, Direction::East) ||
+                  maze.isWall(x, y - 1, Direction::North) ||
+                  maze.isWall(x - 1, y - 1, Direction::North))
+          << (int)x << " " << (int)y;
+    }
+  /* 全区画がスタートから到達可能 */
+  StepMap step_map;
+  step_map.update(maze, {maze.getStart()}, true, true);
+  for (coord_t x = 0; x < maze_size; ++x)
+    for (coord_t y = 0; y < maze_size; ++y)
+      EXPECT_NE(step_map.getStep(x, y), StepMap::step_t(StepMap::STEP_MAX));
+}
+/* 通路の数 */
+static int count_passages(const Maze &maze, const int maze_size) {
+  int n = 0;
+  for (coord_t x = 0; x < maze_size; ++x)
+    for (coord_t y = 0; y < maze_size; ++y)
+      n += !maze.isWall(x, y, Direction::East) +
+           !maze.isWall(x, y, Direction::North);
+  return n;
+}
+/* 東西または南北に通り抜けられる直線の区画の数 */
+static int count_straights(const Maze &maze, const int maze_size) {
+  int n = 0;
+  for (coord_t x = 0; x < maze_size; ++x)
+    for (coord_t y = 0; y < maze_size; ++y) {
+      const auto p = Position(x, y);
+      n += (!maze.isWall(p, Direction::East) &&
+            !maze.isWall(p, Direction::West)) ||
+           (!maze.isWall(p, Direction::North) &&
+            !maze.isWall(p, Direction::South));
+    }
+  return n;
+}
+/* 行き止まりの区画の数 */
+static int count_dead_ends(const Maze &maze, const int maze_size) {
+  int n = 0;
+  for (coord_t x = 0; x < maze_size; ++x)
+    for (coord_t y = 0; y < maze_size; ++y)
+      n += maze.wallCount(Position(x, y)) == 3;
+  return n;
+}
+
+TEST(MazeGenerator, rules) {
+  for (const auto style :
+       {MazeGenerator::Perfect, MazeGenerator::Braided,
+        MazeGenerator::Straight, MazeGenerator::Diagonal})
+    for (const int maze_size : {4, 9, MAZE_SIZE})
+      for (const int goal_size : {1, 2, 3}) {
+        if (goal_size > maze_size - 2)
+          continue;
+        MazeGenerator generator(maze_size * 10 + goal_size);
+        MazeGenerator::Config config;
+        config.maze_size = maze_size;
+        config.goal_size = goal_size;
+        config.style = style;
+        Maze maze;
+        ASSERT_TRUE(generator.generate(maze, config));
+        check_rules(maze, maze_size, goal_size);
+        /* 木構造の通路の数: (区画数 - ゴール区画数 + 1) - 1 + ゴール内の通路 */
+        if (style != MazeGenerator::Braided) {
+          EXPECT_EQ(count_passages(maze, maze_size),
+                    maze_size * maze_size - goal_size * goal_size +
+                        2 * goal_size * (goal_size - 1));
+        }
+      }
+}
+TEST(MazeGenerator, deterministic) {
+  Maze maze1, maze2, maze3;
+  MazeGenerator(123).generate(maze1);
+  MazeGenerator(123).generate(maze2);
+  MazeGenerator(124).generate(maze3);
+  EXPECT_EQ(maze1.getWallBits(), maze2.getWallBits());
+  EXPECT_NE(maze1.getWallBits(), maze3.getWallBits());
+  /* 連続して生成すると別の迷路になる */
+  MazeGenerator generator(123);
+  generator.generate(maze1);
+  generator.generate(maze2);
+  EXPECT_NE(maze1.getWallBits(), maze2.getWallBits());
+  /* 乱数列の固定値 (実装を変えると再現性が失われることに注意) */
+  MazeGenerator rng(0);
+  const uint32_t first = rng.random();
+  rng.setSeed(0);
+  EXPECT_EQ(rng.random(), first);
+  EXPECT_LT(rng.random(10), 10u);
+}
+TEST(MazeGenerator, styles) {
+  int passages[4] = {}, straights[4] = {}, dead_ends[4] = {};
+  for (int seed = 0; seed < 20; ++seed)
+    for (const auto style :
+         {MazeGenerator::Perfect, MazeGenerator::Braided,
+          MazeGenerator::Straight, MazeGenerator::Diagonal}) {
+      MazeGenerator::Config config;
+      config.style = style;
+      Maze maze;
+      MazeGenerator(seed).generate(maze, config);
+      passages[style] += count_passages(maze, MAZE_SIZE);
+      straights[style] += count_straights(maze, MAZE_SIZE);
+      dead_ends[style] += count_dead_ends(maze, MAZE_SIZE);
+    }
+  /* ループが多く，行き止まりが少ない */
+  EXPECT_GT(passages[MazeGenerator::Braided], passages[MazeGenerator::Perfect]);
+  EXPECT_LT(dead_ends[MazeGenerator::Braided] * 4,
+            dead_ends[MazeGenerator::Perfect]);
+  /* 直線が多い */
+  EXPECT_GT(straights[MazeGenerator::Straight],
+            straights[MazeGenerator::Perfect] * 3 / 2);
+  /* 直線が少ない (階段状) */
+  EXPECT_LT(straights[MazeGenerator::Diagonal] * 3 / 2,
+            straights[MazeGenerator::Perfect]);
+}
+TEST(MazeGenerator, invalid) {
+  Maze maze;
+  MazeGenerator generator;
+  MazeGenerator::Config config;
+  config.maze_size = MAZE_SIZE + 1;
+  EXPECT_FALSE(generator.generate(maze, config));
+  config.maze_size = 1;
+  EXPECT_FALSE(generator.generate(maze, config));
+  config.maze_size = 4;
+  config.goal_size = 3;
+  EXPECT_FALSE(generator.generate(maze, config));
+}
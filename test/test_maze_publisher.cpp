@@ -0,0 +1,60 @@
+#include "MazePublisher.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+
+using namespace MazeLib;
+
+TEST(MazePublisher, publish_acquire) {
+  Maze maze;
+  maze.setGoals({Position(1, 1)});
+  MazePublisher publisher(maze);
+  EXPECT_FALSE(publisher.hasUpdate());
+  EXPECT_EQ(publisher.acquire().generation, 0u);
+  EXPECT_EQ(publisher.acquire().goals, maze.getGoals());
+  /* 公開した世代を取得できる */
+  maze.updateWall(Position(1, 0), Direction::East, true);
+  EXPECT_EQ(publisher.publish(maze), 1u);
+  EXPECT_TRUE(publisher.hasUpdate());
+  const auto &s1 = publisher.acquire();
+  EXPECT_FALSE(publisher.hasUpdate());
+  EXPECT_EQ(s1.generation, 1u);
+  EXPECT_TRUE(s1.maze.isWall(Position(1, 0), Direction::East));
+  EXPECT_EQ(s1.start, maze.getStart());
+  EXPECT_EQ(s1.maze.getMaxX(), maze.getMaxX());
+  /* 取得中のスナップショットは公開が続いても変わらない */
+  maze.updateWall(Position(2, 0), Direction::East, true);
+  publisher.publish(maze);
+  maze.updateWall(Position(3, 0), Direction::East, true);
+  publisher.publish(maze);
+  EXPECT_EQ(s1.generation, 1u);
+  EXPECT_FALSE(s1.maze.isWall(Position(2, 0), Direction::East));
+  /* 途中の世代は飛ばして最新の世代を取得する */
+  const auto &s3 = publisher.acquire();
+  EXPECT_EQ(s3.generation, 3u);
+  EXPECT_TRUE(s3.maze.isWall(Position(3, 0), Direction::East));
+  EXPECT_EQ(publisher.acquire().generation, 3u);
+}
+TEST(MazePublisher, threads) {
+  Maze maze;
+  MazePublisher publisher(maze);
+  const size_t known_initial = maze.getKnownBits().count();
+  std::thread writer([&] {
+    /* 壁を1枚ずつ追加して公開する．世代 g では g 枚が既知 */
+    for (coord_t x = 1; x < MAZE_SIZE - 1; ++x)
+      for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+        maze.updateWall(Position(x, y), Direction::East, true);
+        publisher.publish(maze);
+      }
+  });
+  /* 世代と既知壁の数が常に一致すること */
+  const uint32_t last = (MAZE_SIZE - 2) * MAZE_SIZE;
+  uint32_t generation = 0;
+  while (generation < last) {
+    const auto &s = publisher.acquire();
+    ASSERT_GE(s.generation, generation);
+    generation = s.generation;
+    ASSERT_EQ(s.maze.getKnownBits().count(), known_initial + generation);
+  }
+  writer.join();
+}
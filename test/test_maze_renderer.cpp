@@ -0,0 +1,79 @@
+#include "MazeRenderer.h"
+#include "StepMap.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace MazeLib;
+
+static Maze sample_maze() {
+  std::stringstream ss;
+  ss << "+---+---+---+" << std::endl;
+  ss << "|         G |" << std::endl;
+  ss << "+   +---+---+" << std::endl;
+  ss << "|           |" << std::endl;
+  ss << "+   +---+   +" << std::endl;
+  ss << "| S |       |" << std::endl;
+  ss << "+---+---+---+" << std::endl;
+  Maze maze;
+  maze.parse(ss);
+  return maze;
+}
+
+TEST(MazeRenderer, plain) {
+  const auto maze = sample_maze();
+  MazeRenderer renderer(false);
+  std::stringstream ss;
+  renderer.print(maze, {Direction::North, Direction::East}, maze.getStart(),
+                 ss, 3);
+  EXPECT_EQ(ss.str(), renderer.getBuffer());
+  EXPECT_EQ(ss.str(), "+---+---+---+\n"
+                      "|         G |\n"
+                      "+   +---+---+\n"
+                      "|   >       |\n"
+                      "+ ^ +---+   +\n"
+                      "| S |       |\n"
+                      "+---+---+---+\n");
+  std::stringstream ss_positions;
+  renderer.print(maze, Positions{Position(2, 0)}, ss_positions, 3);
+  EXPECT_EQ(ss_positions.str(), "+---+---+---+\n"
+                                "|         G |\n"
+                                "+   +---+---+\n"
+                                "|           |\n"
+                                "+   +---+   +\n"
+                                "| S |     X |\n"
+                                "+---+---+---+\n");
+}
+TEST(MazeRenderer, color) {
+  const auto maze = sample_maze();
+  MazeRenderer renderer;
+  EXPECT_EQ(renderer.isColor(), MazeRenderer::getColorDefault());
+  renderer.setColor(true);
+  std::stringstream ss;
+  renderer.print(maze, Directions{}, maze.getStart(), ss, 3);
+  EXPECT_NE(ss.str().find("\x1b["), std::string::npos);
+  /* 既定値の変更は Maze::print() にも反映される */
+  const bool color_default = MazeRenderer::getColorDefault();
+  MazeRenderer::setColorDefault(false);
+  std::stringstream ss_plain;
+  maze.print(Directions{}, maze.getStart(), ss_plain, 3);
+  EXPECT_EQ(ss_plain.str().find("\x1b["), std::string::npos);
+  MazeRenderer::setColorDefault(color_default);
+}
+TEST(MazeRenderer, step_map) {
+  const auto maze = sample_maze();
+  StepMap step_map;
+  const auto dirs = step_map.calcShortestDirections(maze, false, true);
+  ASSERT_FALSE(dirs.empty());
+  MazeRenderer renderer(false);
+  std::stringstream ss;
+  renderer.print(maze, step_map, dirs, maze.getStart(), ss, 3);
+  /* 経路が通過する壁の数だけ方向が描かれる */
+  const auto &s = ss.str();
+  EXPECT_EQ(size_t(std::count(s.begin(), s.end(), '^') +
+                   std::count(s.begin(), s.end(), '>')),
+            dirs.size());
+  /* ゴールのステップは 0 */
+  EXPECT_NE(s.find("  0"), std::string::npos);
+}
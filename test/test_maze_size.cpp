@@ -1,4 +1,6 @@
 #include "Maze.h"
+#include "MazeGenerator.h"
+#include "StepMap.h"
 #include "gtest/gtest.h"
 
 using namespace MazeLib;
@@ -7,3 +9,72 @@ TEST(MAZE_SIZE, MAZE_SIZE) {
   EXPECT_LE(MAZE_SIZE, MAZE_SIZE_MAX);
   EXPECT_EQ(MAZE_SIZE_MAX, std::pow(2, MAZE_SIZE_BIT));
 }
+
+TEST(MAZE_SIZE, coordinates) {
+  const coord_t n = MAZE_SIZE - 1;
+  const auto p = Position(n, n);
+  EXPECT_TRUE(p.isInsideOfField());
+  EXPECT_FALSE(p.next(Direction::East).isInsideOfField());
+  EXPECT_FALSE(Position(0, 0).next(Direction::South).isInsideOfField());
+  EXPECT_LT(int(p.getIndex()), int(Position::SIZE));
+  /* 壁の通し番号は往復で一致する */
+  for (const auto i : {WallIndex(n, n - 1, 1), WallIndex(n - 1, n, 0)}) {
+    EXPECT_TRUE(i.isInsideOfField());
+    EXPECT_LT(int(i.getIndex()), int(WallIndex::SIZE));
+    EXPECT_EQ(WallIndex(i.getIndex()), i);
+  }
+  EXPECT_FALSE(WallIndex(p, Direction::East).isInsideOfField());
+  const auto r = WallRecord(p, Direction::North, true);
+  EXPECT_EQ(r.getPosition(), p);
+  EXPECT_EQ(r.getDirection(), Direction::North);
+}
+
+TEST(MAZE_SIZE, NeighborTable) {
+  /* 表は Position::next と WallIndex の定義に一致する */
+  const auto &table = NeighborTable::Table;
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+      const auto p = Position(x, y);
+      for (const auto d : Direction::Along4) {
+        const auto i = WallIndex(p, d);
+        const auto cell = table.cell[p.getIndex()][d / 2];
+        const auto wall = table.wall[p.getIndex()][d / 2];
+        EXPECT_EQ(wall != NeighborTable::OUTSIDE, i.isInsideOfField());
+        EXPECT_EQ(cell != NeighborTable::OUTSIDE, i.isInsideOfField());
+        if (i.isInsideOfField()) {
+          EXPECT_EQ(wall, i.getIndex());
+          EXPECT_EQ(cell, p.next(d).getIndex());
+        }
+      }
+    }
+}
+
+TEST(MAZE_SIZE, addStep) {
+  EXPECT_EQ(StepMap::addStep(1, 2), 3);
+  EXPECT_EQ(StepMap::addStep(StepMap::STEP_MAX - 1, 1),
+            StepMap::step_t(StepMap::STEP_MAX));
+  EXPECT_EQ(StepMap::addStep(StepMap::STEP_MAX - 1, 100),
+            StepMap::step_t(StepMap::STEP_MAX));
+}
+
+TEST(MAZE_SIZE, generated_maze) {
+  Maze maze;
+  MazeGenerator(0).generate(maze);
+  StepMap step_map;
+  for (const auto simple : {true, false}) {
+    const auto dirs = step_map.calcShortestDirections(
+        maze, maze.getStart(), maze.getGoals(), true, simple);
+    ASSERT_FALSE(dirs.empty());
+    /* 経路は壁を通らずにゴールに着き，コストは飽和しない */
+    auto p = maze.getStart();
+    for (const auto d : dirs) {
+      EXPECT_FALSE(maze.isWall(p, d));
+      p = p.next(d);
+    }
+    EXPECT_EQ(step_map.getStep(p), 0);
+    EXPECT_LT(step_map.getStep(maze.getStart()),
+              StepMap::step_t(StepMap::STEP_MAX));
+    EXPECT_EQ(step_map.calcRouteCost(dirs, simple),
+              step_map.getStep(maze.getStart()));
+  }
+}
@@ -0,0 +1,85 @@
+#include "MazeGenerator.h"
+#include "MultiAgentPlanner.h"
+#include "gtest/gtest.h"
+
+using namespace MazeLib;
+
+/* 全エージェントが1区画ずつ進む探索を行い，完了までのステップ数を返す */
+static int explore(const Maze &maze_target, Maze &maze, const int agent_count,
+                   const bool full) {
+  MultiAgentPlanner planner(maze, agent_count);
+  std::vector<Pose> poses(agent_count, {maze.getStart(), Direction::North});
+  std::vector<Maze> observed(agent_count);
+  for (int step = 0; step < 4 * MAZE_SIZE * MAZE_SIZE; ++step) {
+    Positions positions;
+    for (int a = 0; a < agent_count; ++a) {
+      for (const auto d : Direction::Along4)
+        observed[a].updateWall(poses[a].p, d,
+                               maze_target.isWall(poses[a].p, d));
+      planner.merge(observed[a]);
+      positions.push_back(poses[a].p);
+    }
+    if (!planner.assign(positions, true, full))
+      return step;
+    for (int a = 0; a < agent_count; ++a) {
+      const auto &dirs = planner.getAssignments()[a].dirs;
+      if (!dirs.empty())
+        poses[a] = poses[a].next(dirs.front());
+    }
+  }
+  return -1;
+}
+
+TEST(MultiAgentPlanner, assign) {
+  Maze maze;
+  maze.setGoals({Position(7, 7)});
+  MultiAgentPlanner planner(maze, 3);
+  EXPECT_EQ(planner.getAgentCount(), 3);
+  const Positions positions = {Position(0, 0), Position(0, 0), Position(3, 3)};
+  EXPECT_TRUE(planner.assign(positions, true, true));
+  const auto &assignments = planner.getAssignments();
+  ASSERT_EQ(assignments.size(), 3u);
+  for (int a = 0; a < 3; ++a) {
+    /* 目的区画は互いに異なり，経路は目的区画に着く */
+    ASSERT_FALSE(assignments[a].dirs.empty());
+    auto p = positions[a];
+    for (const auto d : assignments[a].dirs)
+      p = p.next(d);
+    EXPECT_EQ(p, assignments[a].target);
+    EXPECT_GT(maze.unknownCount(p), 0);
+    for (int b = 0; b < a; ++b)
+      EXPECT_NE(assignments[a].target, assignments[b].target);
+  }
+}
+
+TEST(MultiAgentPlanner, merge) {
+  Maze maze, observed;
+  MultiAgentPlanner planner(maze, 1);
+  observed.updateWall(Position(2, 2), Direction::North, true);
+  EXPECT_TRUE(planner.merge(observed).empty());
+  EXPECT_TRUE(maze.isKnown(Position(2, 2), Direction::North));
+  EXPECT_TRUE(maze.isWall(Position(2, 2), Direction::North));
+}
+
+TEST(MultiAgentPlanner, explore) {
+  Maze maze_target;
+  MazeGenerator(0).generate(maze_target);
+  StepMap step_map;
+  step_map.calcShortestDirections(maze_target, true, true);
+  const auto shortest_cost = step_map.getStep(maze_target.getStart());
+  int steps[2] = {};
+  for (const int agent_count : {1, 2}) {
+    for (const bool full : {false, true}) {
+      Maze maze(maze_target.getGoals());
+      const int step = explore(maze_target, maze, agent_count, full);
+      ASSERT_GE(step, 0);
+      /* 既知壁のみの最短経路は正解の迷路の最短経路と同じコスト */
+      step_map.calcShortestDirections(maze, true, true);
+      EXPECT_EQ(step_map.getStep(maze.getStart()), shortest_cost);
+      if (full)
+        steps[agent_count - 1] = step;
+    }
+  }
+  /* 全区画の探索はエージェントを増やすと短縮される */
+  EXPECT_LT(steps[1], steps[0]);
+}
@@ -0,0 +1,184 @@
+#include "MazeGenerator.h"
+#include "SearchAlgorithm.h"
+#include "gtest/gtest.h"
+#include "sample_maze.h"
+#include <algorithm>
+
+using namespace MazeLib;
+
+TEST(SearchAlgorithm, calcWallGains_known_maze) {
+  const auto maze = getSampleMaze();
+  SearchAlgorithm search_algorithm(maze);
+  EXPECT_TRUE(search_algorithm.calcWallGains(false).empty());
+  EXPECT_TRUE(search_algorithm.findShortestCandidates(false).empty());
+}
+
+TEST(SearchAlgorithm, findShortestCandidates_unknown_wall_on_route) {
+  auto maze = getSampleMaze();
+  StepMap step_map;
+  const auto shortest_dirs = step_map.calcShortestDirections(maze, true, true);
+  ASSERT_FALSE(shortest_dirs.empty());
+  /* 最短経路上の壁をひとつ未知にする */
+  auto p = maze.getStart();
+  for (int i = 0; i < 3; ++i)
+    p = p.next(shortest_dirs[i]);
+  const auto i = WallIndex(p, shortest_dirs[3]);
+  maze.setWall(i, false), maze.setKnown(i, false);
+  /* 最短経路外の壁をひとつ未知にする */
+  const auto j = WallIndex(Position(2, 4), Direction::South);
+  maze.setWall(j, false), maze.setKnown(j, false);
+  SearchAlgorithm search_algorithm(maze);
+  const auto gains = search_algorithm.calcWallGains(true);
+  ASSERT_EQ(gains.size(), 1u);
+  EXPECT_EQ(gains[0].i, i);
+  EXPECT_GT(gains[0].gain, 0);
+  const auto candidates = search_algorithm.findShortestCandidates(true);
+  ASSERT_EQ(candidates.size(), 2u);
+  EXPECT_EQ(candidates[0], p);
+  EXPECT_EQ(candidates[1], p.next(shortest_dirs[3]));
+}
+
+TEST(SearchAlgorithm, findShortestCandidates_zero_gain) {
+  /* 未知壁のみの迷路では各壁の迂回路が存在する */
+  const Maze maze({Position(3, 3)});
+  SearchAlgorithm search_algorithm(maze);
+  const auto gains = search_algorithm.calcWallGains(true);
+  ASSERT_FALSE(gains.empty());
+  for (const auto &g : gains)
+    EXPECT_EQ(g.gain, 0);
+  EXPECT_FALSE(search_algorithm.findShortestCandidates(true).empty());
+}
+
+TEST(SearchAlgorithm, calcWallGains_generated) {
+  /* 壁を増やして再計算したコストが下がっても，増分は桁あふれしない */
+  for (const int seed : {1, 2, 3, 4})
+    for (const int known_percent : {30, 60, 90}) {
+      Maze maze_target;
+      MazeGenerator generator(seed);
+      generator.generate(maze_target);
+      Maze maze(maze_target.getGoals(), maze_target.getStart());
+      for (coord_t x = 0; x < MAZE_SIZE; ++x)
+        for (coord_t y = 0; y < MAZE_SIZE; ++y)
+          for (const auto d : {Direction::East, Direction::North})
+            if (int(generator.random(100)) < known_percent)
+              maze.updateWall(Position(x, y), d, maze_target.isWall(x, y, d));
+      SearchAlgorithm search_algorithm(maze);
+      search_algorithm.isShortestDetermined(0, false);
+      const auto base_step = search_algorithm.getOptimisticShortestCost();
+      for (const auto &g : search_algorithm.calcWallGains(false))
+        EXPECT_LE(g.gain, StepMap::STEP_MAX - base_step);
+    }
+}
+
+TEST(SearchAlgorithm, isShortestDetermined) {
+  const auto maze_target = getSampleMaze();
+  EXPECT_TRUE(SearchAlgorithm(maze_target).isShortestDetermined(0, false));
+  /* 壁を少しずつ更新し，差分更新の結果を毎回の再計算の結果と比較 */
+  Maze maze(maze_target.getGoals(), maze_target.getStart());
+  SearchAlgorithm search_algorithm(maze);
+  EXPECT_FALSE(search_algorithm.isShortestDetermined(0, false));
+  bool determined = false;
+  for (coord_t y = 0; y < 9; ++y)
+    for (coord_t x = 0; x < 9; ++x)
+      for (const auto d : {Direction::East, Direction::North}) {
+        maze.updateWall(Position(x, y), d, maze_target.isWall(x, y, d));
+        for (const auto epsilon : {0, 200}) {
+          const bool result =
+              search_algorithm.isShortestDetermined(epsilon, false);
+          EXPECT_EQ(result,
+                    SearchAlgorithm(maze).isShortestDetermined(epsilon, false));
+          determined |= result;
+        }
+      }
+  EXPECT_TRUE(determined);
+  EXPECT_EQ(search_algorithm.getKnownShortestCost(),
+            search_algorithm.getOptimisticShortestCost());
+}
+
+TEST(SearchAlgorithm, isShortestDetermined_drop_newest) {
+  /* 壁ログが記録を捨てても，差分更新は捨てた壁を含めて追従する */
+  const auto maze_target = getSampleMaze();
+  Maze maze(maze_target.getGoals(), maze_target.getStart());
+  maze.setWallRecordsCapacity(16, WallRecordLog::DropNewest);
+  SearchAlgorithm search_algorithm(maze);
+  for (coord_t y = 0; y < 9; ++y)
+    for (coord_t x = 0; x < 9; ++x)
+      for (const auto d : {Direction::East, Direction::North}) {
+        maze.updateWall(Position(x, y), d, maze_target.isWall(x, y, d));
+        SearchAlgorithm fresh(maze);
+        EXPECT_EQ(search_algorithm.isShortestDetermined(0, false),
+                  fresh.isShortestDetermined(0, false));
+        EXPECT_EQ(search_algorithm.getKnownShortestCost(),
+                  fresh.getKnownShortestCost());
+        EXPECT_EQ(search_algorithm.getOptimisticShortestCost(),
+                  fresh.getOptimisticShortestCost());
+      }
+  EXPECT_GT(maze.getWallRecords().getDroppedCount(), 0u);
+}
+
+TEST(SearchAlgorithm, isShortestDetermined_reset_last) {
+  /* 巻き戻しの直後に別の壁を追加しても，差分更新は全て再計算する */
+  const auto maze_target = getSampleMaze();
+  Maze maze(maze_target.getGoals(), maze_target.getStart());
+  for (coord_t y = 0; y < 9; ++y)
+    for (coord_t x = 0; x < 9; ++x)
+      for (const auto d : {Direction::East, Direction::North})
+        maze.updateWall(Position(x, y), d, maze_target.isWall(x, y, d));
+  SearchAlgorithm search_algorithm(maze);
+  search_algorithm.isShortestDetermined(0, false);
+  maze.resetLastWalls(1);
+  maze.updateWall(maze.getStart(), Direction::North, true); /*< 食い違い */
+  SearchAlgorithm fresh(maze);
+  EXPECT_EQ(search_algorithm.isShortestDetermined(0, false),
+            fresh.isShortestDetermined(0, false));
+  EXPECT_EQ(search_algorithm.getKnownShortestCost(),
+            fresh.getKnownShortestCost());
+  EXPECT_EQ(search_algorithm.getOptimisticShortestCost(),
+            fresh.getOptimisticShortestCost());
+}
+
+TEST(SearchAlgorithm, calcReturnDirections) {
+  auto maze = getSampleMaze();
+  /* ゴール区画内の壁を未知にする */
+  for (coord_t x = 3; x < 5; ++x)
+    for (const auto d : {Direction::East, Direction::North})
+      maze.setWall(Position(x, 4), d, false),
+          maze.setKnown(Position(x, 4), d, false);
+  SearchAlgorithm search_algorithm(maze);
+  StepMap step_map;
+  const auto current = Position(5, 3);
+  const auto known_dirs = step_map.calcShortestDirections(
+      maze, current, {maze.getStart()}, true, false);
+  ASSERT_FALSE(known_dirs.empty());
+  const auto known_cost = step_map.calcRouteCost(known_dirs, false);
+  /* 経路上で観測できる未知壁の数 */
+  const auto count_unknown = [&](const Directions &dirs) {
+    int count = 0;
+    auto p = current;
+    for (const auto d : dirs) {
+      p = p.next(d);
+      for (const auto rd :
+           {Direction::Front, Direction::Left, Direction::Right})
+        count += !maze.isKnown(p, d + rd);
+    }
+    return count;
+  };
+  EXPECT_EQ(count_unknown(known_dirs), 0);
+  /* 時間の余裕がなければ既知壁のみの最短経路 */
+  for (const auto max_cost : {known_cost - 1, int(known_cost)})
+    EXPECT_EQ(search_algorithm.calcReturnDirections(
+                  current, StepMap::step_t(max_cost), 8, false),
+              known_dirs);
+  /* 時間の余裕があれば，上限以内で未知壁を観測できる経路 */
+  const auto max_cost = StepMap::step_t(known_cost * 2);
+  const auto dirs =
+      search_algorithm.calcReturnDirections(current, max_cost, 8, false);
+  const auto cost = step_map.calcRouteCost(dirs, false);
+  EXPECT_GT(cost, known_cost);
+  EXPECT_LE(cost, max_cost);
+  EXPECT_GT(count_unknown(dirs), 0);
+  auto p = current;
+  for (const auto d : dirs)
+    p = p.next(d);
+  EXPECT_EQ(p, maze.getStart());
+}
@@ -0,0 +1,94 @@
+#include "MazeGenerator.h"
+#include "SpeculativePlanner.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace MazeLib;
+
+/* 観測した壁を反映してから直接導出した結果と一致すること */
+static void expect_next_directions(
+    const SpeculativePlanner::NextDirections &speculative, const Maze &maze,
+    const Pose &pose) {
+  StepMap step_map;
+  step_map.update(maze, maze.getGoals(), false, true);
+  Directions known, candidates;
+  const auto end = step_map.calcNextDirections(maze, pose, known, candidates);
+  EXPECT_EQ(speculative.known, known);
+  EXPECT_EQ(speculative.candidates, candidates);
+  EXPECT_EQ(speculative.end.p, end.p);
+  EXPECT_EQ(speculative.end.d, end.d);
+}
+static void check_all_outcomes(SpeculativePlanner &planner, const Maze &maze,
+                               const Pose &next) {
+  planner.prepare(maze, next, maze.getGoals(), false, true);
+  for (int k = 0; k < SpeculativePlanner::OUTCOME_SIZE; ++k) {
+    const bool walls[3] = {bool(k & 1), bool(k & 2), bool(k & 4)};
+    const Direction dirs[3] = {next.d + Direction::Front,
+                               next.d + Direction::Left,
+                               next.d + Direction::Right};
+    Maze observed = maze;
+    for (int i = 0; i < 3; ++i)
+      if (!maze.isKnown(next.p, dirs[i]))
+        observed.updateWall(next.p, dirs[i], walls[i]);
+    SCOPED_TRACE(k);
+    expect_next_directions(planner.lookup(walls[0], walls[1], walls[2]),
+                           observed, next);
+  }
+}
+
+TEST(SpeculativePlanner, outcomes) {
+  Maze maze;
+  maze.setGoals({Position(7, 7)});
+  for (const bool parallel : {true, false}) {
+    SpeculativePlanner planner(parallel);
+    EXPECT_FALSE(planner.isPrepared());
+    EXPECT_TRUE(planner.lookup(false, false, false).known.empty());
+    EXPECT_TRUE(planner.lookup(false, false, false).candidates.empty());
+    /* 3枚とも未知 */
+    const auto next = Pose(Position(1, 1), Direction::North);
+    check_all_outcomes(planner, maze, next);
+    EXPECT_EQ(planner.getOutcomeCount(), 8);
+    EXPECT_EQ(planner.getPose().p, next.p);
+    /* 既知の壁は組合せを展開しない */
+    Maze partial = maze;
+    partial.updateWall(next.p, Direction::East, true);
+    check_all_outcomes(planner, partial, next);
+    EXPECT_EQ(planner.getOutcomeCount(), 4);
+    /* 全て既知 */
+    partial.updateWall(next.p, Direction::North, false);
+    partial.updateWall(next.p, Direction::West, true);
+    check_all_outcomes(planner, partial, next);
+    EXPECT_EQ(planner.getOutcomeCount(), 1);
+  }
+}
+TEST(SpeculativePlanner, search) {
+  /* 生成した迷路を探索し，各区画で直接導出した結果と一致すること */
+  Maze maze_target;
+  MazeGenerator(1).generate(maze_target);
+  Maze maze;
+  maze.setGoals(maze_target.getGoals());
+  SpeculativePlanner planner;
+  auto pose = Pose(Position(0, 0), Direction::North);
+  planner.prepare(maze, pose, maze.getGoals(), false, true);
+  const auto &goals = maze.getGoals();
+  for (int n = 0; n < MAZE_SIZE * MAZE_SIZE; ++n) {
+    const bool walls[3] = {
+        maze_target.isWall(pose.p, pose.d + Direction::Front),
+        maze_target.isWall(pose.p, pose.d + Direction::Left),
+        maze_target.isWall(pose.p, pose.d + Direction::Right)};
+    const auto next = planner.lookup(walls[0], walls[1], walls[2]);
+    maze.updateWall(pose.p, pose.d + Direction::Front, walls[0]);
+    maze.updateWall(pose.p, pose.d + Direction::Left, walls[1]);
+    maze.updateWall(pose.p, pose.d + Direction::Right, walls[2]);
+    expect_next_directions(next, maze, pose);
+    if (std::find(goals.cbegin(), goals.cend(), pose.p) != goals.cend())
+      break;
+    ASSERT_FALSE(next.known.empty() && next.candidates.empty());
+    /* 既知区間の先の区画へ向かいながら先行導出する */
+    pose = next.known.empty() ? pose.next(next.candidates[0]) : next.end;
+    planner.prepare(maze, pose, maze.getGoals(), false, true);
+  }
+  /* ゴールに到達している */
+  EXPECT_NE(std::find(goals.cbegin(), goals.cend(), pose.p), goals.cend());
+}
@@ -0,0 +1,148 @@
+#include "MazeGenerator.h"
+#include "StepMap.h"
+#include "gtest/gtest.h"
+#include "sample_maze.h"
+#include <algorithm>
+
+using namespace MazeLib;
+
+static bool isValidRoute(const Maze &maze, const Directions &dirs) {
+  auto p = maze.getStart();
+  for (const auto d : dirs) {
+    if (maze.isWall(p, d))
+      return false;
+    p = p.next(d);
+  }
+  const auto &goals = maze.getGoals();
+  return std::find(goals.cbegin(), goals.cend(), p) != goals.cend();
+}
+
+TEST(StepMap, calcKShortestRoutes_first_is_shortest) {
+  const auto maze = getSampleMaze();
+  StepMap step_map;
+  for (const auto simple : {true, false}) {
+    const auto routes = step_map.calcKShortestRoutes(
+        maze, maze.getStart(), maze.getGoals(), 1, true, simple);
+    ASSERT_EQ(routes.size(), 1u);
+    EXPECT_EQ(routes[0].cost, step_map.getStep(maze.getStart()));
+    EXPECT_TRUE(isValidRoute(maze, routes[0].dirs));
+    const auto shortest_dirs =
+        step_map.calcShortestDirections(maze, true, simple);
+    EXPECT_EQ(routes[0].cost, step_map.calcRouteCost(shortest_dirs, simple));
+  }
+}
+
+TEST(StepMap, calcKShortestRoutes_distinct_and_sorted) {
+  Maze maze({Position(3, 3)});
+  StepMap step_map;
+  const int k = 8;
+  const auto routes = step_map.calcKShortestRoutes(
+      maze, maze.getStart(), maze.getGoals(), k, false, false);
+  ASSERT_EQ(routes.size(), (size_t)k);
+  for (size_t i = 0; i < routes.size(); ++i) {
+    EXPECT_TRUE(isValidRoute(maze, routes[i].dirs));
+    EXPECT_EQ(routes[i].cost, step_map.calcRouteCost(routes[i].dirs, false));
+    EXPECT_GT(routes[i].unknown_count, 0);
+    if (i > 0) {
+      EXPECT_LE(routes[i - 1].cost, routes[i].cost);
+    }
+    for (size_t j = 0; j < i; ++j)
+      EXPECT_NE(routes[i].dirs, routes[j].dirs);
+  }
+  /* 既知壁のみの経路はひとつもない */
+  EXPECT_TRUE(step_map
+                  .calcKShortestRoutes(maze, maze.getStart(), maze.getGoals(),
+                                       k, true, false)
+                  .empty());
+}
+
+TEST(StepMap, calcKShortestRoutes_no_route) {
+  Maze maze;
+  maze.updateWall(Position(0, 1), Direction::North, true);
+  maze.updateWall(Position(0, 1), Direction::East, true);
+  StepMap step_map;
+  const auto routes = step_map.calcKShortestRoutes(
+      maze, maze.getStart(), {Position(3, 3)}, 3, false, true);
+  EXPECT_TRUE(routes.empty());
+}
+
+TEST(StepMap, update_sweep) {
+  const auto maze = getSampleMaze();
+  StepMap queue_map, sweep_map;
+  for (const auto known_only : {true, false}) {
+    /* 台形加速を考慮しない場合は一致する */
+    queue_map.update(maze, maze.getGoals(), known_only, true, StepMap::Queue);
+    sweep_map.update(maze, maze.getGoals(), known_only, true, StepMap::Sweep);
+    for (coord_t x = 0; x < MAZE_SIZE; ++x)
+      for (coord_t y = 0; y < MAZE_SIZE; ++y)
+        EXPECT_EQ(queue_map.getStep(x, y), sweep_map.getStep(x, y));
+    /* 台形加速を考慮する場合は，キューによる更新の値以下となる */
+    queue_map.update(maze, maze.getGoals(), known_only, false, StepMap::Queue);
+    sweep_map.update(maze, maze.getGoals(), known_only, false, StepMap::Sweep);
+    for (coord_t x = 0; x < MAZE_SIZE; ++x)
+      for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+        EXPECT_LE(sweep_map.getStep(x, y), queue_map.getStep(x, y));
+        EXPECT_EQ(sweep_map.getStep(x, y) == StepMap::STEP_MAX,
+                  queue_map.getStep(x, y) == StepMap::STEP_MAX);
+      }
+  }
+}
+
+TEST(StepMap, update_sweep_dead_end) {
+  const auto maze = getSampleMaze();
+  DeadEndMap dead_end;
+  dead_end.update(maze);
+  StepMap queue_map, sweep_map;
+  queue_map.update(maze, maze.getGoals(), false, true, dead_end,
+                   maze.getStart(), StepMap::Queue);
+  sweep_map.update(maze, maze.getGoals(), false, true, dead_end,
+                   maze.getStart(), StepMap::Sweep);
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y)
+      EXPECT_EQ(queue_map.getStep(x, y), sweep_map.getStep(x, y));
+}
+
+TEST(StepMap, update_sweep_generated) {
+  /* 迷路全体を使う生成した迷路でも Queue と比べて同じ関係となる */
+  for (const auto style : {MazeGenerator::Braided, MazeGenerator::Straight}) {
+    MazeGenerator::Config config;
+    config.style = style;
+    Maze maze;
+    MazeGenerator(0).generate(maze, config);
+    StepMap queue_map, sweep_map;
+    queue_map.update(maze, maze.getGoals(), false, true, StepMap::Queue);
+    sweep_map.update(maze, maze.getGoals(), false, true, StepMap::Sweep);
+    for (coord_t x = 0; x < MAZE_SIZE; ++x)
+      for (coord_t y = 0; y < MAZE_SIZE; ++y)
+        EXPECT_EQ(queue_map.getStep(x, y), sweep_map.getStep(x, y));
+    queue_map.update(maze, maze.getGoals(), false, false, StepMap::Queue);
+    sweep_map.update(maze, maze.getGoals(), false, false, StepMap::Sweep);
+    for (coord_t x = 0; x < MAZE_SIZE; ++x)
+      for (coord_t y = 0; y < MAZE_SIZE; ++y) {
+        EXPECT_LE(sweep_map.getStep(x, y), queue_map.getStep(x, y));
+        EXPECT_EQ(sweep_map.getStep(x, y) == StepMap::STEP_MAX,
+                  queue_map.getStep(x, y) == StepMap::STEP_MAX);
+      }
+  }
+}
+
+TEST(StepMap, StepQueue) {
+  StepQueue q;
+  EXPECT_TRUE(q.empty());
+  /* 予約中の区画は重複しない */
+  q.push(3), q.push(5), q.push(3);
+  EXPECT_EQ(q.size(), 2);
+  EXPECT_EQ(q.pop(), index_t(3));
+  q.push(3);
+  EXPECT_EQ(q.pop(), index_t(5));
+  EXPECT_EQ(q.pop(), index_t(3));
+  EXPECT_TRUE(q.empty());
+  /* 全区画を予約でき，先頭の位置によらず先入れ先出し */
+  for (int i = 0; i < StepQueue::CAPACITY; ++i)
+    q.push(index_t(i));
+  EXPECT_EQ(q.size(), StepQueue::CAPACITY);
+  for (int i = 0; i < StepQueue::CAPACITY; ++i)
+    EXPECT_EQ(q.pop(), index_t(i));
+  q.clear();
+  EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,62 @@
+#include "MazeGenerator.h"
+#include "StepMapAnytime.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+
+using namespace MazeLib;
+
+TEST(StepMapAnytime, resume) {
+  /* 分割して更新しても StepMap::update() と一致すること */
+  for (const int seed : {1, 2, 3})
+    for (const bool known_only : {true, false})
+      for (const bool simple : {true, false})
+        for (const int max_expansions : {1, 7, 64}) {
+          Maze maze;
+          MazeGenerator(seed).generate(maze);
+          StepMap step_map;
+          step_map.update(maze, maze.getGoals(), known_only, simple);
+          StepMapAnytime anytime;
+          anytime.start(maze.getGoals(), known_only, simple);
+          EXPECT_FALSE(anytime.isOptimal());
+          int calls = 0;
+          while (!anytime.resume(maze, max_expansions))
+            ++calls;
+          EXPECT_TRUE(anytime.isOptimal());
+          EXPECT_EQ(calls, (anytime.getExpansionCount() - 1) / max_expansions);
+          EXPECT_EQ(anytime.getMapArray(), step_map.getMapArray());
+        }
+}
+
+TEST(StepMapAnytime, calcBestDirections) {
+  /* 途中の経路は正しく，更新が進むほどコストが下がること */
+  for (const int seed : {1, 2, 3}) {
+    MazeGenerator::Config config;
+    config.style = MazeGenerator::Braided; /*< 複数の経路がある */
+    Maze maze;
+    MazeGenerator(seed).generate(maze, config);
+    StepMapAnytime anytime;
+    anytime.start(maze.getGoals(), false, false);
+    auto cost = StepMap::STEP_MAX;
+    int found = 0;
+    while (!anytime.resume(maze, 4)) {
+      const auto dirs = anytime.calcBestDirections(maze, maze.getStart());
+      if (dirs.empty())
+        continue;
+      ++found;
+      auto p = maze.getStart();
+      for (const auto d : dirs) {
+        EXPECT_FALSE(maze.isWall(p, d));
+        p = p.next(d);
+      }
+      const auto &goals = maze.getGoals();
+      EXPECT_NE(std::find(goals.cbegin(), goals.cend(), p), goals.cend());
+      EXPECT_LE(anytime.getStep(maze.getStart()), cost);
+      cost = anytime.getStep(maze.getStart());
+    }
+    EXPECT_GT(found, 0);
+    /* 収束後は最短経路 */
+    StepMap step_map;
+    const auto shortest = step_map.calcShortestDirections(maze, false, false);
+    EXPECT_EQ(anytime.calcBestDirections(maze, maze.getStart()), shortest);
+  }
+}
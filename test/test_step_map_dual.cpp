@@ -0,0 +1,74 @@
+#include "MazeGenerator.h"
+#include "StepMapDual.h"
+#include "gtest/gtest.h"
+
+using namespace MazeLib;
+
+/* 生成した迷路の壁を一部だけ既知にする */
+static Maze make_partial_maze(const uint64_t seed, const int known_percent) {
+  Maze maze_target, maze;
+  MazeGenerator generator(seed);
+  generator.generate(maze_target);
+  maze.setGoals(maze_target.getGoals());
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y)
+      for (const auto d : {Direction::East, Direction::North})
+        if (int(generator.random(100)) < known_percent)
+          maze.updateWall(Position(x, y), d, maze_target.isWall(x, y, d));
+  return maze;
+}
+
+TEST(StepMapDual, update) {
+  /* 個別に更新した場合と一致すること */
+  for (const int seed : {1, 2, 3})
+    for (const int known_percent : {0, 30, 70, 100})
+      for (const bool simple : {true, false}) {
+        const auto maze = make_partial_maze(seed, known_percent);
+        StepMapDual dual;
+        StepMap optimistic, known;
+        dual.update(maze, maze.getGoals(), simple);
+        optimistic.update(maze, maze.getGoals(), false, simple);
+        known.update(maze, maze.getGoals(), true, simple);
+        EXPECT_EQ(dual.getOptimistic().getMapArray(),
+                  optimistic.getMapArray());
+        EXPECT_EQ(dual.getKnownOnly().getMapArray(), known.getMapArray());
+        EXPECT_EQ(&dual.get(true), &dual.getKnownOnly());
+        /* 袋小路を除外した場合 */
+        DeadEndMap dead_end;
+        dead_end.update(maze);
+        Directions optimistic_dirs, known_dirs;
+        dual.calcShortestDirections(maze, maze.getStart(), maze.getGoals(),
+                                    simple, dead_end, optimistic_dirs,
+                                    known_dirs);
+        EXPECT_EQ(optimistic_dirs,
+                  optimistic.calcShortestDirections(
+                      maze, maze.getStart(), maze.getGoals(), false, simple,
+                      dead_end));
+        EXPECT_EQ(dual.getOptimistic().getMapArray(),
+                  optimistic.getMapArray());
+        EXPECT_EQ(known_dirs, known.calcShortestDirections(
+                                  maze, maze.getStart(), maze.getGoals(),
+                                  true, simple, dead_end));
+        EXPECT_EQ(dual.getKnownOnly().getMapArray(), known.getMapArray());
+        /* 全壁既知なら2つのマップは一致する */
+        if (known_percent == 100) {
+          EXPECT_EQ(dual.getOptimistic().getMapArray(),
+                    dual.getKnownOnly().getMapArray());
+        }
+      }
+}
+TEST(StepMapDual, unreachable) {
+  /* 未知壁のみの迷路では既知壁のみの経路はない */
+  Maze maze;
+  maze.setGoals({Position(3, 3)});
+  StepMapDual dual;
+  DeadEndMap dead_end;
+  dead_end.update(maze);
+  Directions optimistic_dirs, known_dirs;
+  dual.calcShortestDirections(maze, maze.getStart(), maze.getGoals(), false,
+                              dead_end, optimistic_dirs, known_dirs);
+  EXPECT_FALSE(optimistic_dirs.empty());
+  EXPECT_TRUE(known_dirs.empty());
+  EXPECT_EQ(dual.getKnownOnly().getStep(maze.getStart()),
+            StepMap::step_t(StepMap::STEP_MAX));
+}
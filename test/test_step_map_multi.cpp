@@ -0,0 +1,99 @@
+#include "MazeGenerator.h"
+#include "StepMapMulti.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace MazeLib;
+
+/* 生成した迷路の壁を一部だけ既知にする */
+static Maze make_partial_maze(const uint64_t seed, const int known_percent) {
+  Maze maze_target, maze;
+  MazeGenerator generator(seed);
+  generator.generate(maze_target);
+  maze.setGoals(maze_target.getGoals());
+  for (coord_t x = 0; x < MAZE_SIZE; ++x)
+    for (coord_t y = 0; y < MAZE_SIZE; ++y)
+      for (const auto d : {Direction::East, Direction::North})
+        if (int(generator.random(100)) < known_percent)
+          maze.updateWall(Position(x, y), d, maze_target.isWall(x, y, d));
+  return maze;
+}
+/* ゴール，スタート，各候補区画を目的地とする */
+static std::vector<Positions> make_dests(const Maze &maze) {
+  std::vector<Positions> dests = {maze.getGoals(), {maze.getStart()}};
+  for (int k = 0; k < StepMapMulti::LANES - 2; ++k)
+    dests.push_back({Position(k * 2, MAZE_SIZE - 1 - k)});
+  return dests;
+}
+
+TEST(StepMapMulti, simple) {
+  /* 台形加速を考慮しない場合は，各レーンが個別の更新と一致すること */
+  for (const int seed : {1, 2})
+    for (const int known_percent : {0, 50, 100})
+      for (const bool known_only : {false, true}) {
+        const auto maze = make_partial_maze(seed, known_percent);
+        const auto dests = make_dests(maze);
+        StepMapMulti multi;
+        multi.update(maze, dests, known_only, true);
+        EXPECT_EQ(multi.getLaneCount(), int(StepMapMulti::LANES));
+        for (int k = 0; k < StepMapMulti::LANES; ++k) {
+          StepMap step_map, lane;
+          step_map.update(maze, dests[k], known_only, true);
+          multi.copyLane(k, lane);
+          EXPECT_EQ(lane.getMapArray(), step_map.getMapArray()) << k;
+        }
+      }
+}
+TEST(StepMapMulti, trapezoid) {
+  /* 各レーンの経路は目的地に至り，到達可能性は個別の更新と一致すること */
+  for (const int seed : {1, 2, 3})
+    for (const int known_percent : {0, 50, 100}) {
+      const auto maze = make_partial_maze(seed, known_percent);
+      const auto dests = make_dests(maze);
+      StepMapMulti multi;
+      multi.update(maze, dests, false, false);
+      for (int k = 0; k < StepMapMulti::LANES; ++k) {
+        for (const auto p : dests[k])
+          EXPECT_EQ(multi.getStep(k, p), 0);
+        StepMap step_map;
+        const auto expected = step_map.calcShortestDirections(
+            maze, maze.getStart(), dests[k], false, false);
+        const auto dirs =
+            multi.calcShortestDirections(k, maze, maze.getStart(), false);
+        ASSERT_EQ(dirs.empty(), expected.empty()) << k;
+        auto p = maze.getStart();
+        for (const auto d : dirs) {
+          EXPECT_FALSE(maze.isWall(p, d));
+          p = p.next(d);
+        }
+        EXPECT_NE(std::find(dests[k].cbegin(), dests[k].cend(), p),
+                  dests[k].cend());
+      }
+    }
+}
+TEST(StepMapMulti, lanes) {
+  Maze maze;
+  maze.setGoals({Position(3, 3)});
+  StepMapMulti multi;
+  /* 使わないレーンや範囲外は STEP_MAX */
+  multi.update(maze, {maze.getGoals()}, false, true);
+  EXPECT_EQ(multi.getLaneCount(), 1);
+  EXPECT_EQ(multi.getStep(0, Position(3, 3)), 0);
+  EXPECT_EQ(multi.getStep(0, Position(3, 4)), 1);
+  EXPECT_EQ(multi.getSteps(Position(3, 4))[0], 1);
+  EXPECT_EQ(multi.getStep(1, Position(3, 3)),
+            StepMap::step_t(StepMap::STEP_MAX));
+  EXPECT_EQ(multi.getStep(StepMapMulti::LANES, Position(3, 3)),
+            StepMap::step_t(StepMap::STEP_MAX));
+  EXPECT_EQ(multi.getStep(0, Position(-1, 0)),
+            StepMap::step_t(StepMap::STEP_MAX));
+  /* LANES を超える目的地の集合は無視する */
+  std::vector<Positions> dests(StepMapMulti::LANES + 1, maze.getGoals());
+  multi.update(maze, dests, false, true);
+  EXPECT_EQ(multi.getLaneCount(), int(StepMapMulti::LANES));
+  /* 既知壁のみでは到達できない */
+  multi.update(maze, {maze.getGoals()}, true, true);
+  EXPECT_TRUE(multi.calcShortestDirections(0, maze, maze.getStart(), true)
+                  .empty());
+}
@@ -0,0 +1,140 @@
+#include "MazeGenerator.h"
+#include "SearchAlgorithm.h"
+#include "WallBelief.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+
+using namespace MazeLib;
+
+TEST(WallBelief, update) {
+  Maze maze;
+  WallBelief belief;
+  belief.reset(maze);
+  const auto p = Position(2, 3);
+  const auto d = Direction::North;
+  const auto i = WallIndex(p, d);
+  /* 1回の観測で既知になる */
+  EXPECT_TRUE(belief.update(maze, p, d, true));
+  EXPECT_TRUE(maze.isKnown(i) && maze.isWall(i));
+  EXPECT_TRUE(belief.isKnown(i) && belief.isWall(i));
+  /* 繰り返し観測した壁は1回の誤りでは未知壁に戻らない */
+  EXPECT_TRUE(belief.update(maze, p, d, true));
+  EXPECT_FALSE(belief.update(maze, p, d, false));
+  EXPECT_TRUE(maze.isKnown(i) && maze.isWall(i));
+  /* 食い違いが続けば未知壁を経て反転する */
+  EXPECT_FALSE(belief.update(maze, p, d, false));
+  EXPECT_FALSE(maze.isKnown(i));
+  EXPECT_TRUE(belief.update(maze, p, d, false));
+  EXPECT_TRUE(maze.isKnown(i) && !maze.isWall(i));
+  /* 飽和する */
+  for (int n = 0; n < 10; ++n)
+    belief.update(maze, p, d, false);
+  EXPECT_EQ(belief.getLogOdds(i), -belief.getConfig().saturation);
+  /* 初期化した既知の壁と迷路外の壁 */
+  EXPECT_TRUE(belief.isWall(WallIndex(Position(0, 0), Direction::East)));
+  EXPECT_TRUE(belief.isKnown(WallIndex(Position(0, 0), Direction::West)));
+  EXPECT_TRUE(belief.update(maze, Position(0, 0), Direction::East, false) ==
+              false);
+  EXPECT_TRUE(maze.isKnown(Position(0, 0), Direction::East));
+  /* 直前の観測の取り消し */
+  const auto j = WallIndex(Position(4, 4), Direction::East);
+  belief.update(maze, Position(4, 4), Direction::East, true);
+  belief.update(maze, Position(4, 4), Direction::East, true);
+  belief.resetLastWalls(maze, 1);
+  EXPECT_FALSE(maze.isKnown(j));
+  EXPECT_EQ(belief.getLogOdds(j), 0);
+  EXPECT_TRUE(maze.isKnown(i) && !maze.isWall(i));
+  EXPECT_TRUE(belief.isKnown(i) && !belief.isWall(i));
+}
+
+/**
+ * @brief 誤りのある壁センサで最短経路が確定するまで探索したときの走行区画数
+ * @param use_belief true: WallBelief，false: Maze::updateWall()
+ * @return 走行区画数．経路が確定しない場合や，実際の壁を通る経路で
+ *         確定した場合は -1
+ */
+static int searchWithNoise(const Maze &maze_target, const int seed,
+                           const double error_rate, const bool use_belief) {
+  Maze maze(maze_target.getGoals(), maze_target.getStart());
+  WallBelief belief;
+  belief.reset(maze);
+  SearchAlgorithm search_algorithm(maze);
+  StepMap step_map;
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution error(error_rate);
+  Pose pose(maze.getStart(), Direction::North);
+  const int cells_max = 4 * MAZE_SIZE * MAZE_SIZE;
+  int cells = 0;
+  const auto &goals = maze.getGoals();
+  bool reached = false;
+  for (; cells < cells_max; ++cells) {
+    for (const auto rd :
+         {Direction::Front, Direction::Left, Direction::Right}) {
+      const auto d = pose.d + rd;
+      const bool b = maze_target.isWall(pose.p, d) != error(rng);
+      if (use_belief)
+        belief.update(maze, pose.p, d, b);
+      else
+        maze.updateWall(pose.p, d, b);
+    }
+    reached |= std::find(goals.cbegin(), goals.cend(), pose.p) != goals.cend();
+    if (reached && search_algorithm.isShortestDetermined(0, true))
+      break;
+    const auto dest =
+        reached ? search_algorithm.findShortestCandidates(true) : goals;
+    step_map.update(maze, dest, false, true);
+    Directions known_dirs, candidates;
+    step_map.calcNextDirections(maze, pose, known_dirs, candidates);
+    if (known_dirs.empty() && !candidates.empty())
+      known_dirs.push_back(candidates.front());
+    if (known_dirs.empty()) {
+      /* 誤った壁で経路がなくなったので，直前の観測を取り消す */
+      if (maze.getWallRecords().size() == 0)
+        return -1;
+      if (use_belief)
+        belief.resetLastWalls(maze, 16);
+      else
+        maze.resetLastWalls(16);
+      continue;
+    }
+    /* 実際の壁には進めない．その場で再び壁を確認する */
+    const auto d = known_dirs.front();
+    if (maze_target.isWall(pose.p, d))
+      continue;
+    /* 通過した壁は壁なしとして観測する */
+    if (use_belief)
+      belief.update(maze, pose.p, d, false);
+    else
+      maze.updateWall(pose.p, d, false);
+    pose = pose.next(d);
+  }
+  if (cells == cells_max)
+    return -1;
+  /* 確定した最短経路が実際に走行できるか */
+  auto p = maze.getStart();
+  for (const auto d : step_map.calcShortestDirections(maze, true, true)) {
+    if (maze_target.isWall(p, d))
+      return -1;
+    p = p.next(d);
+  }
+  return cells;
+}
+
+TEST(WallBelief, search_with_noise) {
+  /* センサの誤りによる失敗と再探索が減る */
+  int plain = 0, with_belief = 0;
+  int plain_failures = 0, belief_failures = 0;
+  for (int seed = 0; seed < 24; ++seed) {
+    Maze maze_target;
+    MazeGenerator(seed).generate(maze_target);
+    const auto a = searchWithNoise(maze_target, seed, 0.05, false);
+    const auto b = searchWithNoise(maze_target, seed, 0.05, true);
+    plain_failures += a < 0, belief_failures += b < 0;
+    /* 走行区画数は両方が成功した迷路で比べる */
+    if (a >= 0 && b >= 0)
+      plain += a, with_belief += b;
+  }
+  EXPECT_LT(belief_failures, plain_failures);
+  EXPECT_LT(with_belief, plain);
+}
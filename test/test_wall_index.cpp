@@ -18,6 +18,29 @@ TEST(WallIndex, isInsideOfField) {
       WallIndex({0, MAZE_SIZE - 1}, Direction::North).isInsideOfField());
 }
 
+TEST(WallIndex, next) {
+  /* 東の壁から各方向の隣接壁 */
+  const auto e = WallIndex(2, 3, 0);
+  EXPECT_EQ(e.next(Direction::East), WallIndex(3, 3, 0));
+  EXPECT_EQ(e.next(Direction::NorthEast), WallIndex(3, 3, 1));
+  EXPECT_EQ(e.next(Direction::North), WallIndex(2, 4, 0));
+  EXPECT_EQ(e.next(Direction::NorthWest), WallIndex(2, 3, 1));
+  EXPECT_EQ(e.next(Direction::West), WallIndex(1, 3, 0));
+  EXPECT_EQ(e.next(Direction::SouthWest), WallIndex(2, 2, 1));
+  EXPECT_EQ(e.next(Direction::South), WallIndex(2, 2, 0));
+  EXPECT_EQ(e.next(Direction::SouthEast), WallIndex(3, 2, 1));
+  /* 北の壁から各方向の隣接壁 */
+  const auto n = WallIndex(2, 3, 1);
+  EXPECT_EQ(n.next(Direction::East), WallIndex(3, 3, 1));
+  EXPECT_EQ(n.next(Direction::NorthEast), WallIndex(2, 4, 0));
+  EXPECT_EQ(n.next(Direction::North), WallIndex(2, 4, 1));
+  EXPECT_EQ(n.next(Direction::NorthWest), WallIndex(1, 4, 0));
+  EXPECT_EQ(n.next(Direction::West), WallIndex(1, 3, 1));
+  EXPECT_EQ(n.next(Direction::SouthWest), WallIndex(1, 3, 0));
+  EXPECT_EQ(n.next(Direction::South), WallIndex(2, 2, 1));
+  EXPECT_EQ(n.next(Direction::SouthEast), WallIndex(2, 3, 0));
+}
+
 TEST(WallIndex, operator_left_shift_left_shift) {
   std::stringstream ss;
   ss << WallIndex(1, 2, 0);